@@ -0,0 +1,147 @@
+// ----------------------------------
+// projects/deque/AllocationListener.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// ----------------------------------
+
+#ifndef AllocationListener_h
+#define AllocationListener_h
+
+// --------
+// includes
+// --------
+
+#include <cstddef>  // size_t
+#include <fstream>  // ifstream
+#include <iomanip>  // setw
+#include <map>      // map
+#include <ostream>  // ostream
+#include <sstream>  // istringstream, ostringstream
+#include <string>   // getline, string
+
+#include "cppunit/Exception.h"    // Exception
+#include "cppunit/Message.h"      // Message
+#include "cppunit/Test.h"         // Test
+#include "cppunit/TestListener.h" // TestListener
+#include "cppunit/TestResult.h"   // TestResult
+
+#include "CountingAllocator.h"
+
+// ------------------
+// AllocationListener
+// ------------------
+
+/**
+ * Reports the allocations, bytes, and peak live bytes that each test method
+ * makes through CountingAllocator, and fails any test that exceeds its budget.
+ * Tests that never allocate through CountingAllocator (the suites over other
+ * allocators) are neither reported nor checked.
+ *
+ * A budget file has one line per test method (or * for the default):
+ *     # name                 allocations  bytes     peak
+ *     *                      2000         1048576   262144
+ *     test_push_front_4      20000        8388608   1048576
+ * With no budget file, only the report is made; a budget file that is named
+ * but cannot be read, or holds no budgets, fails every test it would have checked.
+ */
+class AllocationListener : public CppUnit::TestListener {
+    private:
+        // ------
+        // Budget
+        // ------
+
+        struct Budget {
+            std::size_t allocations;
+            std::size_t bytes;
+            std::size_t peak;};
+
+    private:
+        // ----
+        // data
+        // ----
+
+        CppUnit::TestResult&          _r;
+        std::ostream&                 _out;
+        std::map<std::string, Budget> _budgets;
+        std::string                   _unread;
+
+    private:
+        // ------
+        // method
+        // ------
+
+        /**
+         * "TestDeque<MyDeque<int> >::test_push_back_1" -> "test_push_back_1"
+         */
+        static std::string method (const std::string& name) {
+            const std::string::size_type i = name.rfind("::");
+            return (i == std::string::npos) ? name : name.substr(i + 2);}
+
+        // ------
+        // budget
+        // ------
+
+        const Budget* budget (const std::string& name) const {
+            std::map<std::string, Budget>::const_iterator b = _budgets.find(method(name));
+            if (b == _budgets.end())
+                b = _budgets.find("*");
+            return (b == _budgets.end()) ? 0 : &b->second;}
+
+    public:
+        // -----------
+        // constructor
+        // -----------
+
+        /**
+         * r is the runner's eventManager(), which receives the budget failures
+         */
+        AllocationListener (CppUnit::TestResult& r, std::ostream& out, const char* budget_file = 0) :
+                _r   (r),
+                _out (out) {
+            if (!budget_file)
+                return;
+            std::ifstream in(budget_file);
+            std::string   line;
+            while (std::getline(in, line)) {
+                std::istringstream sin(line);
+                std::string        name;
+                Budget             b;
+                if ((sin >> name) && (name[0] != '#') && (sin >> b.allocations >> b.bytes >> b.peak))
+                    _budgets[name] = b;}
+            if (_budgets.empty()) {
+                _unread = budget_file;
+                _out << "AllocationListener: no budgets read from " << _unread << std::endl;}}
+
+        // ---------
+        // startTest
+        // ---------
+
+        void startTest (CppUnit::Test*) {
+            reset_allocation_counts();}
+
+        // -------
+        // endTest
+        // -------
+
+        void endTest (CppUnit::Test* t) {
+            const AllocationCounts c = allocation_counts();
+            if (c.allocations == 0)
+                return;
+            const std::string name = t->getName();
+            _out << std::setw(72) << std::left  << name
+                 << std::setw(10) << std::right << c.allocations << " allocs"
+                 << std::setw(12) << c.bytes                     << " bytes"
+                 << std::setw(12) << c.peak                      << " peak"
+                 << std::endl;
+            if (!_unread.empty()) {
+                _r.addFailure(t, new CppUnit::Exception(CppUnit::Message("allocation budget file could not be read", _unread)));
+                return;}
+            const Budget* const b = budget(name);
+            if (!b || ((c.allocations <= b->allocations) && (c.bytes <= b->bytes) && (c.peak <= b->peak)))
+                return;
+            std::ostringstream details;
+            details << c.allocations << " allocs, " << c.bytes << " bytes, " << c.peak << " peak; budget is "
+                    << b->allocations << " allocs, " << b->bytes << " bytes, " << b->peak << " peak";
+            _r.addFailure(t, new CppUnit::Exception(CppUnit::Message("allocation budget exceeded", details.str())));}};
+
+#endif // AllocationListener_h
@@ -0,0 +1,119 @@
+// ---------------------------------------
+// projects/deque/BenchConcurrentDeque.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// ---------------------------------------
+
+/*
+To run the benchmarks:
+    % g++ -std=c++11 -pedantic -O2 -DNDEBUG -Wall -pthread BenchConcurrentDeque.c++ -o BenchConcurrentDeque.c++.app
+    % BenchConcurrentDeque.c++.app > BenchConcurrentDeque.out
+
+One producer thread pushes n ints while one consumer thread pops them;
+each line reports the nanoseconds per item handed across.
+*/
+
+// --------
+// includes
+// --------
+
+#include <chrono>   // steady_clock
+#include <cstddef>  // size_t
+#include <deque>    // deque
+#include <iomanip>  // setw, setprecision
+#include <iostream> // cout, endl
+#include <mutex>    // lock_guard, mutex
+#include <thread>   // thread, yield
+
+#include "ConcurrentDeque.h"
+
+// -----------
+// LockedDeque
+// -----------
+
+/**
+ * what ConcurrentMyDeque replaces: a deque behind a mutex
+ */
+template <typename T>
+class LockedDeque {
+    private:
+        std::mutex    _m;
+        std::deque<T> _x;
+
+    public:
+        void push_back (const T& v) {
+            std::lock_guard<std::mutex> g(_m);
+            _x.push_back(v);}
+
+        bool try_pop_front (T& v) {
+            std::lock_guard<std::mutex> g(_m);
+            if (_x.empty())
+                return false;
+            v = _x.front();
+            _x.pop_front();
+            return true;}};
+
+// --------------------
+// BenchConcurrentDeque
+// --------------------
+
+template <typename C>
+struct BenchConcurrentDeque {
+    // ----
+    // pump
+    // ----
+
+    /**
+     * nanoseconds per item to move 0, 1, ..., n - 1 from one thread to another
+     */
+    static double pump (std::size_t n) {
+        C x;
+        const std::chrono::steady_clock::time_point b = std::chrono::steady_clock::now();
+        std::thread p(
+            [&x, n] () {
+                for (std::size_t i = 0; i != n; ++i)
+                    x.push_back(static_cast<int>(i));});
+        std::size_t i = 0;
+        int         v;
+        while (i != n)
+            if (x.try_pop_front(v))
+                ++i;
+            else
+                std::this_thread::yield();
+        p.join();
+        const std::chrono::steady_clock::time_point e = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(e - b).count() / n;}
+
+    // ---
+    // run
+    // ---
+
+    static void run (const char* name) {
+        using namespace std;
+        for (size_t n = 1000; n <= 10000000; n *= 10) {
+            // best of three, to keep scheduler noise out
+            double t = pump(n);
+            for (int i = 0; i != 2; ++i) {
+                const double u = pump(n);
+                if (u < t)
+                    t = u;}
+            cout << setw(20) << left  << name
+                 << setw(10) << right << n
+                 << fixed
+                 << setw(12) << setprecision(2) << t << " ns/item"
+                 << endl;}}};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "BenchConcurrentDeque.c++" << endl << endl;
+
+    BenchConcurrentDeque< ConcurrentMyDeque<int> >::run("ConcurrentMyDeque");
+    BenchConcurrentDeque< LockedDeque<int>       >::run("mutex + deque");
+
+    cout << endl << "Done." << endl;
+    return 0;}
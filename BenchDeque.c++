@@ -0,0 +1,478 @@
+// -----------------------------
+// projects/deque/BenchDeque.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// -----------------------------
+
+/*
+To run the benchmarks:
+    % g++ -ansi -pedantic -O2 -DNDEBUG -Wall BenchDeque.c++ -o BenchDeque.c++.app -lrt
+    % BenchDeque.c++.app          >  BenchDeque.out
+    % BenchDeque.c++.app 100000   >  BenchDeque.out    # cap the largest size
+
+Each line reports, for one container, operation, and size,
+the wall-clock nanoseconds per operation and the heap allocations per operation.
+std_copy and std_fill go through iterators; seg_copy and seg_fill go a block
+at a time through Segments.h for MyDeque, and are std_copy and std_fill for deque.
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // copy, fill
+#include <cstddef>   // size_t
+#include <cstdlib>   // atol, malloc, free
+#include <ctime>     // clock_gettime
+#include <deque>     // deque
+#include <iomanip>   // setw, setprecision
+#include <iostream>  // cout, endl
+#include <new>       // bad_alloc
+#include <vector>    // vector
+
+#include "Deque.h"
+#include "PoolAllocator.h"
+#include "Segments.h"
+
+// -----------
+// Allocations
+// -----------
+
+struct Allocations {
+    static std::size_t count;
+    static std::size_t bytes;};
+
+std::size_t Allocations::count = 0;
+std::size_t Allocations::bytes = 0;
+
+void* operator new (std::size_t s) throw (std::bad_alloc) {
+    ++Allocations::count;
+    Allocations::bytes += s;
+    if (void* const p = std::malloc(s ? s : 1))
+        return p;
+    throw std::bad_alloc();}
+
+void operator delete (void* p) throw () {
+    std::free(p);}
+
+void* operator new[] (std::size_t s) throw (std::bad_alloc) {
+    return operator new(s);}
+
+void operator delete[] (void* p) throw () {
+    operator delete(p);}
+
+// ------
+// append
+// ------
+
+/**
+ * deque only has range insert; MyDeque has append and prepend.
+ */
+template <typename C, typename I>
+void append (C& x, I b, I e) {
+    x.insert(x.end(), b, e);}
+
+template <typename T, typename A, typename P, typename I>
+void append (MyDeque<T, A, P>& x, I b, I e) {
+    x.append(b, e);}
+
+// -------
+// prepend
+// -------
+
+template <typename C, typename I>
+void prepend (C& x, I b, I e) {
+    x.insert(x.begin(), b, e);}
+
+template <typename T, typename A, typename P, typename I>
+void prepend (MyDeque<T, A, P>& x, I b, I e) {
+    x.prepend(b, e);}
+
+// --------
+// seg_copy
+// --------
+
+/**
+ * deque has no segments; MyDeque copies and fills a block at a time.
+ */
+template <typename C, typename O>
+O seg_copy (const C& x, O out) {
+    return std::copy(x.begin(), x.end(), out);}
+
+template <typename T, typename A, typename P, typename O>
+O seg_copy (const MyDeque<T, A, P>& x, O out) {
+    return segmented_copy(x, out);}
+
+// --------
+// seg_fill
+// --------
+
+template <typename C>
+void seg_fill (C& x, const typename C::value_type& v) {
+    std::fill(x.begin(), x.end(), v);}
+
+template <typename T, typename A, typename P>
+void seg_fill (MyDeque<T, A, P>& x, const T& v) {
+    segmented_fill(x, v);}
+
+// ------
+// Sample
+// ------
+
+/**
+ * Measures the wall-clock time and heap allocations between start() and stop().
+ */
+class Sample {
+    private:
+        timespec    _b;
+        std::size_t _allocations;
+
+    public:
+        std::size_t ops;
+        double      ns;
+        std::size_t allocations;
+
+        Sample () :
+                ops         (0),
+                ns          (0),
+                allocations (0)
+            {}
+
+        void start () {
+            _allocations = Allocations::count;
+            clock_gettime(CLOCK_MONOTONIC, &_b);}
+
+        void stop (std::size_t n) {
+            timespec e;
+            clock_gettime(CLOCK_MONOTONIC, &e);
+            ns          += (e.tv_sec - _b.tv_sec) * 1e9 + (e.tv_nsec - _b.tv_nsec);
+            allocations += Allocations::count - _allocations;
+            ops         += n;}};
+
+// ----------
+// BenchDeque
+// ----------
+
+template <typename C>
+struct BenchDeque {
+    // keeps the optimizer from discarding reads
+    static volatile int sink;
+
+    // ---------
+    // push_back
+    // ---------
+
+    /**
+     * the container is built and destroyed inside the timed region, like in
+     * bench_fill, so a deque that allocates on construction and one that
+     * allocates on the first push pay the same
+     */
+    static void bench_push_back (Sample& s, std::size_t n) {
+        s.start();
+        {
+        C x;
+        for (std::size_t i = 0; i != n; ++i)
+            x.push_back(static_cast<int>(i));
+        }
+        s.stop(n);}
+
+    // ----------
+    // push_front
+    // ----------
+
+    static void bench_push_front (Sample& s, std::size_t n) {
+        s.start();
+        {
+        C x;
+        for (std::size_t i = 0; i != n; ++i)
+            x.push_front(static_cast<int>(i));
+        }
+        s.stop(n);}
+
+    // --------
+    // pop_back
+    // --------
+
+    static void bench_pop_back (Sample& s, std::size_t n) {
+        C x(n, 2);
+        s.start();
+        for (std::size_t i = 0; i != n; ++i)
+            x.pop_back();
+        s.stop(n);}
+
+    // ---------
+    // pop_front
+    // ---------
+
+    static void bench_pop_front (Sample& s, std::size_t n) {
+        C x(n, 2);
+        s.start();
+        for (std::size_t i = 0; i != n; ++i)
+            x.pop_front();
+        s.stop(n);}
+
+    // ---------
+    // subscript
+    // ---------
+
+    static void bench_subscript (Sample& s, std::size_t n) {
+        C x(n, 2);
+        int t = 0;
+        s.start();
+        for (std::size_t i = 0; i != n; ++i)
+            t += x[i];
+        s.stop(n);
+        sink = t;}
+
+    // -------
+    // iterate
+    // -------
+
+    static void bench_iterate (Sample& s, std::size_t n) {
+        C x(n, 2);
+        int t = 0;
+        s.start();
+        typename C::iterator b = x.begin();
+        typename C::iterator e = x.end();
+        while (b != e) {
+            t += *b;
+            ++b;}
+        s.stop(n);
+        sink = t;}
+
+    // -----
+    // equal
+    // -----
+
+    static void bench_equal (Sample& s, std::size_t n) {
+        const C x(n, 2);
+        C y;
+        for (std::size_t i = 0; i != n; ++i)
+            y.push_front(2);
+        s.start();
+        sink = (x == y);
+        s.stop(n);}
+
+    // ----
+    // less
+    // ----
+
+    static void bench_less (Sample& s, std::size_t n) {
+        const C x(n, 2);
+        C y(x);
+        y.back() = 3;
+        s.start();
+        sink = (x < y);
+        s.stop(n);}
+
+    // ------
+    // insert
+    // ------
+
+    static void bench_insert (Sample& s, std::size_t n) {
+        // inserting in the middle is linear, so only time a bounded number of them
+        const std::size_t k = n < 100 ? n : 100;
+        C x(n, 2);
+        s.start();
+        for (std::size_t i = 0; i != k; ++i)
+            x.insert(x.begin() + x.size() / 2, 3);
+        s.stop(k);}
+
+    // -----
+    // erase
+    // -----
+
+    static void bench_erase (Sample& s, std::size_t n) {
+        const std::size_t k = n < 100 ? n : 100;
+        C x(n, 2);
+        s.start();
+        for (std::size_t i = 0; i != k; ++i)
+            x.erase(x.begin() + x.size() / 2);
+        s.stop(k);}
+
+    // ----
+    // fill
+    // ----
+
+    static void bench_fill (Sample& s, std::size_t n) {
+        s.start();
+        {
+        const C x(n, 2);
+        sink = x.size() ? x[0] : 0;
+        }
+        s.stop(n);}
+
+    // ------
+    // append
+    // ------
+
+    static void bench_append (Sample& s, std::size_t n) {
+        const std::vector<int> a(n, 2);
+        C x(1, 1);
+        s.start();
+        append(x, a.begin(), a.end());
+        s.stop(n);}
+
+    // -------
+    // prepend
+    // -------
+
+    static void bench_prepend (Sample& s, std::size_t n) {
+        const std::vector<int> a(n, 2);
+        C x(1, 1);
+        s.start();
+        prepend(x, a.begin(), a.end());
+        s.stop(n);}
+
+    // ---------
+    // ins_range
+    // ---------
+
+    static void bench_ins_range (Sample& s, std::size_t n) {
+        const std::vector<int> a(n, 2);
+        C x(n, 1);
+        s.start();
+        x.insert(x.begin() + n / 2, a.begin(), a.end());
+        s.stop(n);}
+
+    // ------
+    // resize
+    // ------
+
+    static void bench_resize (Sample& s, std::size_t n) {
+        s.start();
+        {
+        C x;
+        x.resize(n, 2);
+        x.resize(n / 2);
+        x.resize(n, 3);
+        }
+        s.stop(n);}
+
+    // ----
+    // copy
+    // ----
+
+    static void bench_copy (Sample& s, std::size_t n) {
+        const C x(n, 2);
+        s.start();
+        {
+        const C y(x);
+        sink = y.size() ? y[0] : 0;
+        }
+        s.stop(n);}
+
+    // --------
+    // std_copy
+    // --------
+
+    static void bench_std_copy (Sample& s, std::size_t n) {
+        const C          x(n, 2);
+        std::vector<int> a(n);
+        s.start();
+        std::copy(x.begin(), x.end(), a.begin());
+        s.stop(n);
+        sink = n ? a[n - 1] : 0;}
+
+    // --------
+    // seg_copy
+    // --------
+
+    static void bench_seg_copy (Sample& s, std::size_t n) {
+        const C          x(n, 2);
+        std::vector<int> a(n);
+        s.start();
+        seg_copy(x, a.begin());
+        s.stop(n);
+        sink = n ? a[n - 1] : 0;}
+
+    // --------
+    // std_fill
+    // --------
+
+    static void bench_std_fill (Sample& s, std::size_t n) {
+        C x(n, 2);
+        s.start();
+        std::fill(x.begin(), x.end(), 3);
+        s.stop(n);
+        sink = n ? x[n - 1] : 0;}
+
+    // --------
+    // seg_fill
+    // --------
+
+    static void bench_seg_fill (Sample& s, std::size_t n) {
+        C x(n, 2);
+        s.start();
+        seg_fill(x, 3);
+        s.stop(n);
+        sink = n ? x[n - 1] : 0;}
+
+    // ------
+    // report
+    // ------
+
+    /**
+     * Repeats f until 2^20 operations or 0.2 seconds have been timed
+     * and prints one line of results.
+     */
+    static void report (const char* name, const char* op, void (*f) (Sample&, std::size_t), std::size_t n) {
+        Sample s;
+        do {
+            f(s, n);}
+        while ((s.ops < (1U << 20)) && (s.ns < 2e8));
+        using namespace std;
+        cout << setw(8)  << left  << name
+             << setw(12) << left  << op
+             << setw(10) << right << n
+             << fixed
+             << setw(12) << setprecision(2) << s.ns / s.ops << " ns/op"
+             << setw(10) << setprecision(4) << static_cast<double>(s.allocations) / s.ops << " allocs/op"
+             << endl;}
+
+    // ---
+    // run
+    // ---
+
+    static void run (const char* name, std::size_t m) {
+        for (std::size_t n = 10; n <= m; n *= 10) {
+            report(name, "push_back",  bench_push_back,  n);
+            report(name, "push_front", bench_push_front, n);
+            report(name, "pop_back",   bench_pop_back,   n);
+            report(name, "pop_front",  bench_pop_front,  n);
+            report(name, "subscript",  bench_subscript,  n);
+            report(name, "iterate",    bench_iterate,    n);
+            report(name, "equal",      bench_equal,      n);
+            report(name, "less",       bench_less,       n);
+            report(name, "insert",     bench_insert,     n);
+            report(name, "erase",      bench_erase,      n);
+            report(name, "fill",       bench_fill,       n);
+            report(name, "append",     bench_append,     n);
+            report(name, "prepend",    bench_prepend,    n);
+            report(name, "ins_range",  bench_ins_range,  n);
+            report(name, "resize",     bench_resize,     n);
+            report(name, "copy",       bench_copy,       n);
+            report(name, "std_copy",   bench_std_copy,   n);
+            report(name, "seg_copy",   bench_seg_copy,   n);
+            report(name, "std_fill",   bench_std_fill,   n);
+            report(name, "seg_fill",   bench_seg_fill,   n);}}};
+
+template <typename C>
+volatile int BenchDeque<C>::sink = 0;
+
+// ----
+// main
+// ----
+
+int main (int argc, char* argv[]) {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "BenchDeque.c++" << endl << endl;
+
+    const std::size_t m = (argc > 1) ? atol(argv[1]) : 10000000;
+    BenchDeque< MyDeque<int>                     >::run("MyDeque", m);
+    BenchDeque< MyDeque<int, PoolAllocator<int> > >::run("pooled",  m);
+    BenchDeque<   deque<int>                     >::run("deque",   m);
+
+    cout << endl << "Done." << endl;
+    return 0;}
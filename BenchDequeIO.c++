@@ -0,0 +1,166 @@
+// -------------------------------
+// projects/deque/BenchDequeIO.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// -------------------------------
+
+/*
+To run the benchmarks:
+    % g++ -ansi -pedantic -O2 -DNDEBUG -Wall BenchDequeIO.c++ -o BenchDequeIO.c++.app -lrt
+    % BenchDequeIO.c++.app          >  BenchDequeIO.out
+    % BenchDequeIO.c++.app 100000   >  BenchDequeIO.out    # fewer elements
+
+Each line reports, for one container and way of checkpointing it,
+the wall-clock nanoseconds per element and the megabytes of elements per second.
+"stream" writes and reads one element at a time with << and >> through an
+ofstream and an ifstream, the way a checkpoint is written without DequeIO.h.
+Every way goes through the same temporary file and none of them calls fsync,
+so all of them are timed against the page cache, not the disk.
+*/
+
+// --------
+// includes
+// --------
+
+#include <cstddef>  // size_t
+#include <cstdlib>  // atol, mkstemp
+#include <cstring>  // strcpy
+#include <ctime>    // clock_gettime
+#include <deque>    // deque
+#include <fstream>  // ifstream, ofstream
+#include <iomanip>  // setw, setprecision
+#include <iostream> // cout, endl
+#include <memory>   // allocator
+
+#include <unistd.h> // close, lseek, unlink
+
+#include "BlockPolicy.h"
+#include "Deque.h"
+#include "DequeIO.h"
+
+// -----
+// Timer
+// -----
+
+/**
+ * wall-clock nanoseconds since construction
+ */
+class Timer {
+    private:
+        timespec _b;
+
+    public:
+        Timer () {
+            clock_gettime(CLOCK_MONOTONIC, &_b);}
+
+        double ns () const {
+            timespec e;
+            clock_gettime(CLOCK_MONOTONIC, &e);
+            return (e.tv_sec - _b.tv_sec) * 1e9 + (e.tv_nsec - _b.tv_nsec);}};
+
+// ------------
+// BenchDequeIO
+// ------------
+
+template <typename C>
+struct BenchDequeIO {
+    typedef typename C::value_type T;
+
+    // keeps the optimizer from discarding reads
+    static volatile T sink;
+
+    // ------
+    // report
+    // ------
+
+    static void report (const char* name, const char* op, std::size_t n, double ns) {
+        using namespace std;
+        cout << setw(8)  << left  << name
+             << setw(12) << left  << op
+             << setw(10) << right << n
+             << fixed
+             << setw(12) << setprecision(2) << ns / n                          << " ns/elem"
+             << setw(12) << setprecision(1) << (n * sizeof(T)) / (ns / 1e3)   << " MB/s"
+             << endl;}
+
+    // ---
+    // run
+    // ---
+
+    static void run (const char* name, std::size_t n) {
+        C x;
+        for (std::size_t i = 0; i != n; ++i)
+            x.push_back(static_cast<T>(i));
+
+        char p[32];
+        std::strcpy(p, "/tmp/BenchDequeIO.XXXXXX");
+        const int fd = mkstemp(p);
+        if (fd < 0) {
+            std::cout << name << ": mkstemp failed" << std::endl;
+            return;}
+
+        {
+        Timer t;
+        save(fd, x);
+        report(name, "save", n, t.ns());
+        }
+
+        {
+        C y;
+        ::lseek(fd, 0, SEEK_SET);
+        Timer t;
+        load(fd, y);
+        report(name, "load", n, t.ns());
+        }
+
+        {
+        Timer                t;
+        const MappedDeque<T> m(p);
+        T                    s = T();
+        for (typename MappedDeque<T>::const_iterator b = m.begin(); b != m.end(); ++b)
+            s += *b;
+        sink = s;
+        report(name, "map", n, t.ns());
+        }
+
+        {
+        Timer         t;
+        std::ofstream out(p);
+        for (typename C::const_iterator b = x.begin(); b != x.end(); ++b)
+            out << *b << ' ';
+        out.close();
+        report(name, "stream_out", n, t.ns());
+        }
+
+        {
+        Timer         t;
+        std::ifstream in(p);
+        C             y;
+        T             v;
+        while (in >> v)
+            y.push_back(v);
+        report(name, "stream_in", n, t.ns());
+        }
+
+        ::close(fd);
+        ::unlink(p);}};
+
+template <typename C>
+volatile typename C::value_type BenchDequeIO<C>::sink = 0;
+
+// ----
+// main
+// ----
+
+int main (int argc, char* argv[]) {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "BenchDequeIO.c++" << endl << endl;
+
+    const std::size_t n = (argc > 1) ? atol(argv[1]) : 10000000;
+    BenchDequeIO< MyDeque<int>                                 >::run("MyDeque", n);
+    BenchDequeIO< MyDeque<int, allocator<int>, FixedBlock<16> > >::run("small",   n);
+    BenchDequeIO<   deque<int>                                 >::run("deque",   n);
+
+    cout << endl << "Done." << endl;
+    return 0;}
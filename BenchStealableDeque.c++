@@ -0,0 +1,148 @@
+// --------------------------------------
+// projects/deque/BenchStealableDeque.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// --------------------------------------
+
+/*
+To run the benchmark:
+    % g++ -std=c++11 -pedantic -O2 -DNDEBUG -Wall -pthread BenchStealableDeque.c++ -o BenchStealableDeque.c++.app
+    % BenchStealableDeque.c++.app      > BenchStealableDeque.out
+    % BenchStealableDeque.c++.app 38   > BenchStealableDeque.out    # fib(38)
+
+Computes fib(n) on a small work-stealing pool, one StealableDeque per worker,
+with 1, 2, ..., hardware_concurrency() workers, and reports the time and the
+speedup over one worker.
+*/
+
+// --------
+// includes
+// --------
+
+#include <atomic>   // atomic
+#include <chrono>   // steady_clock
+#include <cstdlib>  // atoi
+#include <iomanip>  // setw, setprecision
+#include <iostream> // cout, endl
+#include <memory>   // unique_ptr
+#include <thread>   // hardware_concurrency, thread, yield
+#include <vector>   // vector
+
+#include "StealableDeque.h"
+
+// ---
+// fib
+// ---
+
+long fib (int n) {
+    return (n < 2) ? n : fib(n - 1) + fib(n - 2);}
+
+// ----
+// Pool
+// ----
+
+/**
+ * A task is just the n of a fib(n) still to be added up.
+ * Below cutoff a task runs sequentially; above it, it pushes fib(n - 1)
+ * for someone to pick up and carries on with fib(n - 2) itself.
+ */
+class Pool {
+    private:
+        static const int cutoff = 20;
+
+        const int                                             _m;
+        std::vector< std::unique_ptr< StealableDeque<int> > > _q;
+        std::vector<long>                                     _sums;
+        std::atomic<long>                                     _pending;
+
+        // ---
+        // run
+        // ---
+
+        void run (int w, int n) {
+            while (n >= cutoff) {
+                _pending.fetch_add(1, std::memory_order_relaxed);
+                _q[w]->push_back(n - 1);
+                n -= 2;}
+            _sums[w] += fib(n);
+            _pending.fetch_sub(1, std::memory_order_acq_rel);}
+
+        // ----
+        // work
+        // ----
+
+        void work (int w) {
+            unsigned r = w + 1;
+            int      n;
+            while (_pending.load(std::memory_order_acquire) != 0) {
+                if (_q[w]->pop_back(n)) {
+                    run(w, n);
+                    continue;}
+                r = r * 1103515245 + 12345;
+                const int v = (r >> 16) % _m;
+                if ((v != w) && _q[v]->steal(n))
+                    run(w, n);
+                else
+                    std::this_thread::yield();}}
+
+    public:
+        // -----------
+        // constructor
+        // -----------
+
+        explicit Pool (int m) :
+                _m       (m),
+                _sums    (m, 0),
+                _pending (0) {
+            for (int i = 0; i != m; ++i)
+                _q.push_back(std::unique_ptr< StealableDeque<int> >(new StealableDeque<int>));}
+
+        // -------
+        // compute
+        // -------
+
+        long compute (int n) {
+            _pending.store(1);
+            _q[0]->push_back(n);
+            std::vector<std::thread> t;
+            for (int i = 1; i != _m; ++i)
+                t.push_back(std::thread(&Pool::work, this, i));
+            work(0);
+            for (int i = 0; i != _m - 1; ++i)
+                t[i].join();
+            long s = 0;
+            for (int i = 0; i != _m; ++i)
+                s += _sums[i];
+            return s;}};
+
+// ----
+// main
+// ----
+
+int main (int argc, char* argv[]) {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "BenchStealableDeque.c++" << endl << endl;
+
+    const int  n = (argc > 1) ? atoi(argv[1]) : 36;
+    const long f = fib(n);
+    const int  m = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    double     one = 0;
+    for (int w = 1; w <= m; ++w) {
+        Pool p(w);
+        const chrono::steady_clock::time_point b = chrono::steady_clock::now();
+        const long                             s = p.compute(n);
+        const chrono::steady_clock::time_point e = chrono::steady_clock::now();
+        const double                           t = chrono::duration<double, milli>(e - b).count();
+        if (w == 1)
+            one = t;
+        cout << "fib(" << n << ")"
+             << setw(4) << w << " workers"
+             << fixed
+             << setw(12) << setprecision(2) << t << " ms"
+             << setw(8)  << setprecision(2) << one / t << "x"
+             << ((s == f) ? "" : "  WRONG")
+             << endl;}
+
+    cout << endl << "Done." << endl;
+    return 0;}
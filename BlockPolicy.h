@@ -0,0 +1,100 @@
+// ---------------------------
+// projects/deque/BlockPolicy.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// ---------------------------
+
+#ifndef BlockPolicy_h
+#define BlockPolicy_h
+
+/*
+Compile-time layout policies for MyDeque<T, A, P>.
+
+A policy P answers two questions about a MyDeque of T:
+    P::template block_size<T>::value  elements per heap block, at least 1
+    P::inline_capacity                elements MyDeque keeps inside itself
+                                      before it allocates anything at all
+*/
+
+// --------
+// includes
+// --------
+
+#include <cstddef> // size_t
+
+// ------------
+// at_least_one
+// ------------
+
+template <std::size_t N>
+struct at_least_one {
+    static const std::size_t value = N ? N : 1;};
+
+// ----------
+// FixedBlock
+// ----------
+
+/**
+ * N elements per block, whatever T is
+ */
+template <std::size_t N>
+struct FixedBlock {
+    template <typename T>
+    struct block_size {
+        static const std::size_t value = at_least_one<N>::value;};
+
+    static const std::size_t inline_capacity = 0;};
+
+// ----------
+// BytesBlock
+// ----------
+
+/**
+ * blocks of about N bytes, so big T get fewer elements per block
+ */
+template <std::size_t N = 4096>
+struct BytesBlock {
+    template <typename T>
+    struct block_size {
+        static const std::size_t value = at_least_one<N / sizeof(T)>::value;};
+
+    static const std::size_t inline_capacity = 0;};
+
+// --------------
+// CacheLineBlock
+// --------------
+
+/**
+ * blocks of N cache lines of L bytes
+ */
+template <std::size_t N = 16, std::size_t L = 64>
+struct CacheLineBlock {
+    template <typename T>
+    struct block_size {
+        static const std::size_t value = at_least_one<(N * L) / sizeof(T)>::value;};
+
+    static const std::size_t inline_capacity = 0;};
+
+// ------------
+// DefaultBlock
+// ------------
+
+typedef BytesBlock<> DefaultBlock;
+
+// -----------
+// InlineBlock
+// -----------
+
+/**
+ * P's block size, plus room for N elements inside the MyDeque itself,
+ * so a deque that never holds more than N never touches the heap
+ */
+template <std::size_t N, typename P = DefaultBlock>
+struct InlineBlock {
+    template <typename T>
+    struct block_size {
+        static const std::size_t value = P::template block_size<T>::value;};
+
+    static const std::size_t inline_capacity = N;};
+
+#endif // BlockPolicy_h
@@ -0,0 +1,233 @@
+// -------------------------------
+// projects/deque/ConcurrentDeque.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// -------------------------------
+
+#ifndef ConcurrentDeque_h
+#define ConcurrentDeque_h
+
+/*
+ConcurrentMyDeque<T, B> is a work queue for exactly one producer thread,
+which calls push_back/emplace_back, and exactly one consumer thread,
+which calls try_pop_front/empty. Needs C++11.
+
+Elements live in fixed blocks of B, like MyDeque's, chained front to back.
+The producer publishes each element with a release store of its block's
+end; the consumer reads it with an acquire load, so neither side ever waits
+for the other. The consumer keeps its own copy of the last end it read and
+goes back to the shared one only when it has caught up with that copy, so
+the end's cache line moves between the two cores once per catch-up, not
+once per element. A block the consumer has drained goes back to the producer
+through a one-block spare slot, so a queue that stays short stops allocating.
+*/
+
+// --------
+// includes
+// --------
+
+#include <atomic>      // atomic, memory_order
+#include <cstddef>     // size_t
+#include <new>         // new
+#include <type_traits> // aligned_storage
+#include <utility>     // forward, move
+
+// -----------------
+// ConcurrentMyDeque
+// -----------------
+
+template <typename T, std::size_t B = (sizeof(T) < 256) ? 4096 / sizeof(T) : 16>
+class ConcurrentMyDeque {
+    public:
+        // --------
+        // typedefs
+        // --------
+
+        typedef T           value_type;
+        typedef std::size_t size_type;
+
+    private:
+        // -----
+        // Block
+        // -----
+
+        struct Block {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type a[B];
+            std::atomic<size_type>                                     end;
+            std::atomic<Block*>                                        next;
+
+            Block () :
+                    end  (0),
+                    next (nullptr)
+                {}
+
+            T* at (size_type i) {
+                return reinterpret_cast<T*>(&a[i]);}};
+
+    private:
+        // ----
+        // data
+        // ----
+
+        // producer, consumer, and the hand-off between them,
+        // padded apart so the two threads do not share cache lines
+        Block*              _back;
+        size_type           _back_end;
+        char                _pad0[64];
+        Block*              _front;
+        size_type           _front_begin;
+        size_type           _front_end;
+        char                _pad1[64];
+        std::atomic<Block*> _spare;
+        char                _pad2[64];
+
+    private:
+        // -----
+        // block
+        // -----
+
+        /**
+         * producer side: the spare block if the consumer left one, else a new one
+         */
+        Block* block () {
+            Block* b = _spare.exchange(nullptr, std::memory_order_acquire);
+            if (!b)
+                return new Block;
+            b->end.store(0, std::memory_order_relaxed);
+            b->next.store(nullptr, std::memory_order_relaxed);
+            return b;}
+
+        // -------
+        // recycle
+        // -------
+
+        /**
+         * consumer side
+         */
+        void recycle (Block* b) {
+            delete _spare.exchange(b, std::memory_order_acq_rel);}
+
+        // -------
+        // reserve
+        // -------
+
+        /**
+         * producer side: room for one more element at the back
+         */
+        T* reserve () {
+            if (_back_end == B) {
+                Block* const b = block();
+                _back->next.store(b, std::memory_order_release);
+                _back     = b;
+                _back_end = 0;}
+            return _back->at(_back_end);}
+
+        // -------
+        // publish
+        // -------
+
+        /**
+         * producer side: hands the element reserve() made room for to the consumer
+         */
+        void publish () {
+            _back->end.store(++_back_end, std::memory_order_release);}
+
+    public:
+        // ------------
+        // constructors
+        // ------------
+
+        ConcurrentMyDeque () :
+                _back        (new Block),
+                _back_end    (0),
+                _front       (_back),
+                _front_begin (0),
+                _front_end   (0),
+                _spare       (nullptr)
+            {}
+
+        ConcurrentMyDeque             (const ConcurrentMyDeque&) = delete;
+        ConcurrentMyDeque& operator = (const ConcurrentMyDeque&) = delete;
+
+        // ----------
+        // destructor
+        // ----------
+
+        /**
+         * neither thread may still be using the queue
+         */
+        ~ConcurrentMyDeque () {
+            while (_front) {
+                Block* const    b = _front;
+                const size_type e = b->end.load(std::memory_order_acquire);
+                for (size_type i = _front_begin; i != e; ++i)
+                    b->at(i)->~T();
+                _front       = b->next.load(std::memory_order_acquire);
+                _front_begin = 0;
+                delete b;}
+            delete _spare.load(std::memory_order_acquire);}
+
+        // ---------
+        // push_back
+        // ---------
+
+        void push_back (const value_type& v) {
+            new (reserve()) T(v);
+            publish();}
+
+        void push_back (value_type&& v) {
+            new (reserve()) T(std::move(v));
+            publish();}
+
+        // ------------
+        // emplace_back
+        // ------------
+
+        template <typename... Args>
+        void emplace_back (Args&&... args) {
+            new (reserve()) T(std::forward<Args>(args)...);
+            publish();}
+
+        // -------------
+        // try_pop_front
+        // -------------
+
+        /**
+         * consumer side: moves the front element into v and returns true,
+         * or returns false if the producer has not published one yet
+         */
+        bool try_pop_front (value_type& v) {
+            if (_front_begin == B) {
+                Block* const n = _front->next.load(std::memory_order_acquire);
+                if (!n)
+                    return false;
+                recycle(_front);
+                _front       = n;
+                _front_begin = 0;
+                _front_end   = 0;}
+            if (_front_begin == _front_end) {
+                _front_end = _front->end.load(std::memory_order_acquire);
+                if (_front_begin == _front_end)
+                    return false;}
+            T* const p = _front->at(_front_begin);
+            v = std::move(*p);
+            p->~T();
+            ++_front_begin;
+            return true;}
+
+        // -----
+        // empty
+        // -----
+
+        /**
+         * consumer side: true if try_pop_front would return false right now
+         */
+        bool empty () const {
+            if (_front_begin != _front_end)
+                return false;
+            if (_front_begin == B) {
+                const Block* const n = _front->next.load(std::memory_order_acquire);
+                return !n || !n->end.load(std::memory_order_acquire);}
+            return _front_begin == _front->end.load(std::memory_order_acquire);}};
+
+#endif // ConcurrentDeque_h
@@ -0,0 +1,161 @@
+// ---------------------------------
+// projects/deque/CountingAllocator.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// ---------------------------------
+
+#ifndef CountingAllocator_h
+#define CountingAllocator_h
+
+// --------
+// includes
+// --------
+
+#include <cstddef> // ptrdiff_t, size_t
+#include <memory>  // allocator
+#include <new>     // new
+
+// ----------------
+// AllocationCounts
+// ----------------
+
+/**
+ * Heap traffic seen by every CountingAllocator, whatever it was rebound to.
+ * allocations and bytes only ever grow; live goes down on deallocate;
+ * peak is the high-water mark of live.
+ */
+struct AllocationCounts {
+    std::size_t allocations;
+    std::size_t bytes;
+    std::size_t live;
+    std::size_t peak;};
+
+inline AllocationCounts& allocation_counts () {
+    static AllocationCounts c = {0, 0, 0, 0};
+    return c;}
+
+/**
+ * Starts a new measurement; memory that is still live stays live.
+ */
+inline void reset_allocation_counts () {
+    AllocationCounts& c = allocation_counts();
+    c.allocations = 0;
+    c.bytes       = 0;
+    c.peak        = c.live;}
+
+// -----------------
+// CountingAllocator
+// -----------------
+
+/**
+ * A std::allocator that records every allocation in allocation_counts().
+ * Use it as MyDeque<T, CountingAllocator<T> >.
+ */
+template <typename T>
+class CountingAllocator {
+    public:
+        // --------
+        // typedefs
+        // --------
+
+        typedef T                 value_type;
+
+        typedef std::size_t       size_type;
+        typedef std::ptrdiff_t    difference_type;
+
+        typedef value_type*       pointer;
+        typedef const value_type* const_pointer;
+
+        typedef value_type&       reference;
+        typedef const value_type& const_reference;
+
+        template <typename U>
+        struct rebind {
+            typedef CountingAllocator<U> other;};
+
+    public:
+        // -----------
+        // operator ==
+        // -----------
+
+        friend bool operator == (const CountingAllocator&, const CountingAllocator&) {
+            return true;}
+
+        // -----------
+        // operator !=
+        // -----------
+
+        friend bool operator != (const CountingAllocator& lhs, const CountingAllocator& rhs) {
+            return !(lhs == rhs);}
+
+    public:
+        // ------------
+        // constructors
+        // ------------
+
+        CountingAllocator ()
+            {}
+
+        template <typename U>
+        CountingAllocator (const CountingAllocator<U>&)
+            {}
+
+        // Default copy, destructor, and copy assignment.
+        // CountingAllocator  (const CountingAllocator&);
+        // ~CountingAllocator ();
+        // CountingAllocator& operator = (const CountingAllocator&);
+
+        // -------
+        // address
+        // -------
+
+        pointer address (reference v) const {
+            return &v;}
+
+        const_pointer address (const_reference v) const {
+            return &v;}
+
+        // --------
+        // allocate
+        // --------
+
+        pointer allocate (size_type s, const void* = 0) {
+            const pointer p = std::allocator<T>().allocate(s);
+            AllocationCounts& c = allocation_counts();
+            ++c.allocations;
+            c.bytes += s * sizeof(T);
+            c.live  += s * sizeof(T);
+            if (c.live > c.peak)
+                c.peak = c.live;
+            return p;}
+
+        // ---------
+        // construct
+        // ---------
+
+        void construct (pointer p, const_reference v) {
+            new (p) T(v);}
+
+        // ----------
+        // deallocate
+        // ----------
+
+        void deallocate (pointer p, size_type s) {
+            allocation_counts().live -= s * sizeof(T);
+            std::allocator<T>().deallocate(p, s);}
+
+        // -------
+        // destroy
+        // -------
+
+        void destroy (pointer p) {
+            p->~T();}
+
+        // --------
+        // max_size
+        // --------
+
+        size_type max_size () const {
+            return std::allocator<T>().max_size();}};
+
+#endif // CountingAllocator_h
@@ -0,0 +1,450 @@
+// -----------------------
+// projects/deque/DequeIO.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// -----------------------
+
+#ifndef DequeIO_h
+#define DequeIO_h
+
+/*
+Checkpoints of deques of a trivially copyable T (int, double, plain structs);
+any other T, std::string say, is rejected at compile time. For a container
+other than MyDeque, T also has to be default constructible.
+
+A saved deque is a 32-byte DequeHeader followed by its elements, raw and
+contiguous, front to back:
+    save(fd, x)          writes x to the file descriptor fd
+    load(fd, x)          replaces the contents of x with what fd holds
+    MappedDeque<T> m(p)  maps the file at path p and reads it in place
+
+Everything goes through a 64 KiB buffer, so a MyDeque with small blocks
+still costs one system call per 64 KiB. load appends each buffer to the
+deque, which writes every element exactly once. save gathers MyDeque's
+blocks a run at a time (see Segments.h); blocks of 64 KiB or more are
+written straight from the deque, with no copy.
+A failed system call throws std::runtime_error; a file of the wrong element
+size or format, or one that is shorter than its header says, throws
+std::invalid_argument. Files move between machines with the same byte order
+and a 64-bit unsigned long, like the elements themselves.
+*/
+
+// --------
+// includes
+// --------
+
+#include <cerrno>    // errno, EINTR
+#include <cstddef>   // size_t
+#include <cstring>   // memcmp, memcpy, strerror
+#include <stdexcept> // invalid_argument, out_of_range, runtime_error
+#include <string>    // string
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat, S_ISREG
+#include <unistd.h>   // close, lseek, read, write
+
+#include "BlockPolicy.h"
+#include "Deque.h"
+#include "Segments.h"
+
+// -----------
+// DequeHeader
+// -----------
+
+struct DequeHeader {
+    char          magic[4];  // "MYDQ"
+    unsigned      version;   // 1
+    unsigned long width;     // sizeof(T)
+    unsigned long size;      // number of elements
+    unsigned long reserved;  // keeps the elements 32-byte aligned
+
+    static DequeHeader make (std::size_t w, std::size_t s) {
+        DequeHeader h;
+        std::memcpy(h.magic, "MYDQ", 4);
+        h.version  = 1;
+        h.width    = w;
+        h.size     = s;
+        h.reserved = 0;
+        return h;}
+
+    /**
+     * throws std::invalid_argument unless this is a version 1 header for elements of w bytes
+     */
+    void check (std::size_t w) const {
+        if ((std::memcmp(magic, "MYDQ", 4) != 0) || (version != 1))
+            throw std::invalid_argument("DequeIO: not a saved deque");
+        if (width != w)
+            throw std::invalid_argument("DequeIO: saved with a different element size");}};
+
+// the format has 64-bit unsigned longs; a 32-bit build must not write 20-byte headers
+typedef char DequeHeader_must_be_32_bytes[(sizeof(DequeHeader) == 32) ? 1 : -1];
+
+namespace DequeIO {
+
+// -------
+// trivial
+// -------
+
+/**
+ * fails to compile unless T can be saved as its bytes
+ */
+template <typename T>
+struct trivial {
+    char T_must_be_trivially_copyable[(__has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T)) ? 1 : -1];};
+
+// ---------
+// write_all
+// ---------
+
+inline void write_all (int fd, const void* p, std::size_t s) {
+    const char* b = static_cast<const char*>(p);
+    while (s) {
+        const ssize_t n = ::write(fd, b, s);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string("DequeIO: write: ") + std::strerror(errno));}
+        b += n;
+        s -= n;}}
+
+// --------
+// read_all
+// --------
+
+inline void read_all (int fd, void* p, std::size_t s) {
+    char* b = static_cast<char*>(p);
+    while (s) {
+        const ssize_t n = ::read(fd, b, s);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string("DequeIO: read: ") + std::strerror(errno));}
+        if (n == 0)
+            throw std::invalid_argument("DequeIO: file is truncated");
+        b += n;
+        s -= n;}}
+
+// ------
+// Writer
+// ------
+
+/**
+ * writes each run for_each_segment hands it
+ */
+struct Writer {
+    int fd;
+
+    explicit Writer (int f) :
+            fd (f)
+        {}
+
+    template <typename T>
+    void operator () (const T* p, std::size_t k) const {
+        write_all(fd, p, k * sizeof(T));}};
+
+// -----------
+// read_header
+// -----------
+
+/**
+ * reads and checks the header at fd's offset; if fd is a regular file,
+ * also checks that the rest of it holds as many elements as the header says
+ */
+template <typename T>
+DequeHeader read_header (int fd) {
+    DequeHeader h;
+    read_all(fd, &h, sizeof(h));
+    h.check(sizeof(T));
+    struct stat st;
+    if ((::fstat(fd, &st) != 0) || !S_ISREG(st.st_mode))
+        return h;
+    const off_t o = ::lseek(fd, 0, SEEK_CUR);
+    if (o < 0)
+        return h;
+    const unsigned long r = (o < st.st_size) ? static_cast<unsigned long>(st.st_size - o) : 0;
+    if (h.size > r / sizeof(T))
+        throw std::invalid_argument("DequeIO: file is truncated");
+    return h;}
+
+// ------
+// buffer
+// ------
+
+const std::size_t buffer = 65536;
+
+// ------
+// Buffer
+// ------
+
+/**
+ * about buffer bytes of T, left uninitialized
+ */
+template <typename T>
+struct Buffer {
+    const std::size_t k;
+    T* const          a;
+
+    Buffer () :
+            k ((buffer / sizeof(T)) ? buffer / sizeof(T) : 1),
+            a (new T[k])
+        {}
+
+    ~Buffer () {
+        delete [] a;}
+
+    private:
+        Buffer             (const Buffer&);
+        Buffer& operator = (const Buffer&);};
+
+// ------
+// Gather
+// ------
+
+/**
+ * copies each run for_each_segment hands it into a Buffer,
+ * and writes the Buffer each time it fills; flush() writes the rest
+ */
+template <typename T>
+struct Gather {
+    int         fd;
+    Buffer<T>*  b;
+    std::size_t i;
+
+    Gather (int f, Buffer<T>& u) :
+            fd (f),
+            b  (&u),
+            i  (0)
+        {}
+
+    void operator () (const T* p, std::size_t n) {
+        while (n) {
+            const std::size_t c = (n < b->k - i) ? n : b->k - i;
+            std::memcpy(b->a + i, p, c * sizeof(T));
+            i += c;
+            p += c;
+            n -= c;
+            if (i == b->k)
+                flush();}}
+
+    void flush () {
+        write_all(fd, b->a, i * sizeof(T));
+        i = 0;}};
+
+// ------
+// append
+// ------
+
+/**
+ * deque only has range insert; MyDeque has append.
+ */
+template <typename C, typename T>
+void append (C& x, const T* b, const T* e) {
+    x.insert(x.end(), b, e);}
+
+template <typename T, typename A, typename P>
+void append (MyDeque<T, A, P>& x, const T* b, const T* e) {
+    x.append(b, e);}
+
+} // DequeIO
+
+// ----
+// save
+// ----
+
+template <typename C>
+void save (int fd, const C& x) {
+    typedef typename C::value_type T;
+    static_cast<void>(sizeof(DequeIO::trivial<T>));
+    const DequeHeader h = DequeHeader::make(sizeof(T), x.size());
+    DequeIO::write_all(fd, &h, sizeof(h));
+    DequeIO::Buffer<T>         u;
+    typename C::const_iterator b = x.begin();
+    typename C::const_iterator e = x.end();
+    while (b != e) {
+        std::size_t i = 0;
+        while ((i != u.k) && (b != e))
+            u.a[i++] = *b++;
+        DequeIO::write_all(fd, u.a, i * sizeof(T));}}
+
+template <typename T, typename A, typename P>
+void save (int fd, const MyDeque<T, A, P>& x) {
+    static_cast<void>(sizeof(DequeIO::trivial<T>));
+    const DequeHeader h = DequeHeader::make(sizeof(T), x.size());
+    DequeIO::write_all(fd, &h, sizeof(h));
+    if (P::template block_size<T>::value * sizeof(T) >= DequeIO::buffer) {
+        for_each_segment(x, DequeIO::Writer(fd));
+        return;}
+    DequeIO::Buffer<T> u;
+    for_each_segment(x, DequeIO::Gather<T>(fd, u)).flush();}
+
+// ----
+// load
+// ----
+
+/**
+ * reads a buffer at a time and appends it, so a corrupt size
+ * runs out of file before it runs out of memory
+ */
+template <typename C>
+void load (int fd, C& x) {
+    typedef typename C::value_type T;
+    static_cast<void>(sizeof(DequeIO::trivial<T>));
+    const DequeHeader  h = DequeIO::read_header<T>(fd);
+    DequeIO::Buffer<T> u;
+    C                  y;
+    for (std::size_t s = h.size; s != 0; ) {
+        const std::size_t i = (s < u.k) ? s : u.k;
+        DequeIO::read_all(fd, u.a, i * sizeof(T));
+        DequeIO::append(y, u.a, u.a + i);
+        s -= i;}
+    x.swap(y);}
+
+// -----------
+// MappedDeque
+// -----------
+
+/**
+ * A read-only view of a saved deque, mapped straight from the file.
+ * Its iterators are plain pointers, so it is random access with no block
+ * boundaries at all; nothing is copied until an element is touched.
+ */
+template <typename T>
+class MappedDeque {
+    public:
+        // --------
+        // typedefs
+        // --------
+
+        typedef T              value_type;
+
+        typedef std::size_t    size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef const T*       const_pointer;
+        typedef const T&       const_reference;
+
+        typedef const T*       const_iterator;
+        typedef const_iterator iterator;
+
+    private:
+        enum {check = sizeof(DequeIO::trivial<T>)};
+
+    private:
+        // ----
+        // data
+        // ----
+
+        void*       _p;
+        std::size_t _s;
+        const T*    _b;
+        const T*    _e;
+
+        // not copyable
+        MappedDeque             (const MappedDeque&);
+        MappedDeque& operator = (const MappedDeque&);
+
+    public:
+        // -----------
+        // constructor
+        // -----------
+
+        explicit MappedDeque (const char* path) :
+                _p (MAP_FAILED),
+                _s (0),
+                _b (0),
+                _e (0) {
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error(std::string("MappedDeque: open: ") + std::strerror(errno));
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                const int n = errno;
+                ::close(fd);
+                throw std::runtime_error(std::string("MappedDeque: fstat: ") + std::strerror(n));}
+            _s = st.st_size;
+            if (_s < sizeof(DequeHeader)) {
+                ::close(fd);
+                throw std::invalid_argument("MappedDeque: not a saved deque");}
+            _p = ::mmap(0, _s, PROT_READ, MAP_SHARED, fd, 0);
+            const int n = errno;
+            ::close(fd);
+            if (_p == MAP_FAILED)
+                throw std::runtime_error(std::string("MappedDeque: mmap: ") + std::strerror(n));
+            try {
+                const DequeHeader& h = *static_cast<const DequeHeader*>(_p);
+                h.check(sizeof(T));
+                if (h.size > (_s - sizeof(DequeHeader)) / sizeof(T))
+                    throw std::invalid_argument("MappedDeque: file is truncated");
+                _b = reinterpret_cast<const T*>(static_cast<const char*>(_p) + sizeof(DequeHeader));
+                _e = _b + h.size;}
+            catch (...) {
+                ::munmap(_p, _s);
+                throw;}}
+
+        // ----------
+        // destructor
+        // ----------
+
+        ~MappedDeque () {
+            ::munmap(_p, _s);}
+
+        // -----------
+        // operator []
+        // -----------
+
+        const_reference operator [] (size_type i) const {
+            return _b[i];}
+
+        // --
+        // at
+        // --
+
+        const_reference at (size_type i) const {
+            if (i >= size())
+                throw std::out_of_range("MappedDeque::at");
+            return _b[i];}
+
+        // -----
+        // begin
+        // -----
+
+        const_iterator begin () const {
+            return _b;}
+
+        // ---
+        // end
+        // ---
+
+        const_iterator end () const {
+            return _e;}
+
+        // -----
+        // front
+        // -----
+
+        const_reference front () const {
+            return *_b;}
+
+        // ----
+        // back
+        // ----
+
+        const_reference back () const {
+            return _e[-1];}
+
+        // -----
+        // empty
+        // -----
+
+        bool empty () const {
+            return _b == _e;}
+
+        // ----
+        // size
+        // ----
+
+        size_type size () const {
+            return _e - _b;}};
+
+#endif // DequeIO_h
@@ -0,0 +1,252 @@
+// -----------------------------
+// projects/deque/PoolAllocator.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// -----------------------------
+
+#ifndef PoolAllocator_h
+#define PoolAllocator_h
+
+// --------
+// includes
+// --------
+
+#include <cstddef> // ptrdiff_t, size_t
+#include <map>     // map
+#include <new>     // bad_alloc, new, operator new, operator delete
+
+// ---------
+// ChunkPool
+// ---------
+
+/**
+ * Free lists of recycled chunks, one per chunk size.
+ * A freed chunk holds the pointer to the next free chunk of its size,
+ * so the lists cost nothing beyond the chunks themselves.
+ * A list is made the first time a chunk of its size is allocated, so
+ * deallocate never allocates and never throws.
+ * Chunks larger than max_pooled, and chunks that would take the pool past
+ * max_cached bytes, go straight back to the heap; release() empties the pool.
+ * Not thread safe.
+ */
+class ChunkPool {
+    private:
+        // ----
+        // Free
+        // ----
+
+        struct Free {
+            Free* next;};
+
+        typedef std::map<std::size_t, Free*> free_lists;
+
+    public:
+        static const std::size_t max_pooled = 65536;
+        static const std::size_t max_cached = 16777216;
+
+    private:
+        // ----
+        // data
+        // ----
+
+        free_lists  _free;
+        std::size_t _cached;
+
+        // ----
+        // size
+        // ----
+
+        static std::size_t size (std::size_t s) {
+            return (s < sizeof(Free)) ? sizeof(Free) : s;}
+
+    public:
+        // -----------
+        // constructor
+        // -----------
+
+        ChunkPool () :
+                _cached (0)
+            {}
+
+        // ----------
+        // destructor
+        // ----------
+
+        ~ChunkPool () {
+            release();}
+
+        // --------
+        // allocate
+        // --------
+
+        void* allocate (std::size_t s) {
+            s = size(s);
+            if (s <= max_pooled) {
+                free_lists::iterator b = _free.lower_bound(s);
+                if ((b == _free.end()) || (b->first != s))
+                    b = _free.insert(b, free_lists::value_type(s, static_cast<Free*>(0)));
+                if (b->second) {
+                    Free* const p = b->second;
+                    b->second = p->next;
+                    _cached -= s;
+                    return p;}}
+            return ::operator new(s);}
+
+        // ----------
+        // deallocate
+        // ----------
+
+        void deallocate (void* p, std::size_t s) {
+            s = size(s);
+            free_lists::iterator b = (s <= max_pooled) ? _free.find(s) : _free.end();
+            if ((b == _free.end()) || (_cached + s > max_cached)) {
+                ::operator delete(p);
+                return;}
+            Free* const q = static_cast<Free*>(p);
+            q->next   = b->second;
+            b->second = q;
+            _cached  += s;}
+
+        // -------
+        // release
+        // -------
+
+        /**
+         * Returns every recycled chunk to the heap.
+         */
+        void release () {
+            free_lists::iterator b = _free.begin();
+            free_lists::iterator e = _free.end();
+            while (b != e) {
+                while (b->second) {
+                    Free* const p = b->second;
+                    b->second = p->next;
+                    ::operator delete(p);}
+                ++b;}
+            _cached = 0;}
+
+        // ------
+        // cached
+        // ------
+
+        /**
+         * bytes held in the free lists
+         */
+        std::size_t cached () const {
+            return _cached;}};
+
+inline ChunkPool& chunk_pool () {
+    static ChunkPool p;
+    return p;}
+
+// -------------
+// PoolAllocator
+// -------------
+
+/**
+ * A std::allocator that recycles chunks through chunk_pool(), so a MyDeque that keeps
+ * freeing and reallocating blocks of the same size stops going back to the heap.
+ * Use it as MyDeque<T, PoolAllocator<T> >.
+ */
+template <typename T>
+class PoolAllocator {
+    public:
+        // --------
+        // typedefs
+        // --------
+
+        typedef T                 value_type;
+
+        typedef std::size_t       size_type;
+        typedef std::ptrdiff_t    difference_type;
+
+        typedef value_type*       pointer;
+        typedef const value_type* const_pointer;
+
+        typedef value_type&       reference;
+        typedef const value_type& const_reference;
+
+        template <typename U>
+        struct rebind {
+            typedef PoolAllocator<U> other;};
+
+    public:
+        // -----------
+        // operator ==
+        // -----------
+
+        friend bool operator == (const PoolAllocator&, const PoolAllocator&) {
+            return true;}
+
+        // -----------
+        // operator !=
+        // -----------
+
+        friend bool operator != (const PoolAllocator& lhs, const PoolAllocator& rhs) {
+            return !(lhs == rhs);}
+
+    public:
+        // ------------
+        // constructors
+        // ------------
+
+        PoolAllocator ()
+            {}
+
+        template <typename U>
+        PoolAllocator (const PoolAllocator<U>&)
+            {}
+
+        // Default copy, destructor, and copy assignment.
+        // PoolAllocator  (const PoolAllocator&);
+        // ~PoolAllocator ();
+        // PoolAllocator& operator = (const PoolAllocator&);
+
+        // -------
+        // address
+        // -------
+
+        pointer address (reference v) const {
+            return &v;}
+
+        const_pointer address (const_reference v) const {
+            return &v;}
+
+        // --------
+        // allocate
+        // --------
+
+        pointer allocate (size_type s, const void* = 0) {
+            if (s > max_size())
+                throw std::bad_alloc();
+            return static_cast<pointer>(chunk_pool().allocate(s * sizeof(T)));}
+
+        // ---------
+        // construct
+        // ---------
+
+        void construct (pointer p, const_reference v) {
+            new (p) T(v);}
+
+        // ----------
+        // deallocate
+        // ----------
+
+        void deallocate (pointer p, size_type s) {
+            chunk_pool().deallocate(p, s * sizeof(T));}
+
+        // -------
+        // destroy
+        // -------
+
+        void destroy (pointer p) {
+            p->~T();}
+
+        // --------
+        // max_size
+        // --------
+
+        size_type max_size () const {
+            return size_type(-1) / sizeof(T);}};
+
+#endif // PoolAllocator_h
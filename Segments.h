@@ -0,0 +1,145 @@
+// ------------------------
+// projects/deque/Segments.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// ------------------------
+
+#ifndef Segments_h
+#define Segments_h
+
+/*
+Algorithms over a segmented container, one that can hand out the contiguous
+run of elements starting at any of its iterators:
+    std::pair<pointer,       size_type> segment (iterator);
+    std::pair<const_pointer, size_type> segment (const_iterator) const;
+For b != end(), segment(b) is (&*b, k) with 1 <= k <= end() - b,
+and [b, b + k) sits in one block. MyDeque provides both.
+
+Each algorithm walks a block at a time, so the inner loops run over plain
+pointers with no block-boundary check and can be vectorized.
+
+They are named segmented_* rather than being overloads of std::equal,
+std::copy, and std::fill: a program may not add overloads to namespace std,
+and a qualified std:: call never finds one elsewhere by argument-dependent
+lookup. MyDeque's == and < call them; other code calls them by name.
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // copy, fill, lexicographical_compare, min, mismatch
+#include <utility>   // pair
+
+// ----------------
+// for_each_segment
+// ----------------
+
+/**
+ * calls f(p, k) on each contiguous run [p, p + k) of x, front to back
+ */
+template <typename C, typename F>
+F for_each_segment (C& x, F f) {
+    typename C::iterator b = x.begin();
+    typename C::iterator e = x.end();
+    while (b != e) {
+        const std::pair<typename C::pointer, typename C::size_type> s = x.segment(b);
+        f(s.first, s.second);
+        b += s.second;}
+    return f;}
+
+template <typename C, typename F>
+F for_each_segment (const C& x, F f) {
+    typename C::const_iterator b = x.begin();
+    typename C::const_iterator e = x.end();
+    while (b != e) {
+        const std::pair<typename C::const_pointer, typename C::size_type> s = x.segment(b);
+        f(s.first, s.second);
+        b += s.second;}
+    return f;}
+
+// ---------------
+// segmented_equal
+// ---------------
+
+/**
+ * x == y, compared a run at a time; the runs of x and y need not line up
+ */
+template <typename C>
+bool segmented_equal (const C& x, const C& y) {
+    typedef std::pair<typename C::const_pointer, typename C::size_type> segment;
+    if (x.size() != y.size())
+        return false;
+    typename C::const_iterator b = x.begin();
+    typename C::const_iterator c = y.begin();
+    typename C::const_iterator e = x.end();
+    while (b != e) {
+        const segment                s = x.segment(b);
+        const segment                t = y.segment(c);
+        const typename C::size_type  k = std::min(s.second, t.second);
+        if (!std::equal(s.first, s.first + k, t.first))
+            return false;
+        b += k;
+        c += k;}
+    return true;}
+
+// --------------
+// segmented_less
+// --------------
+
+/**
+ * x < y, lexicographically, compared a run at a time
+ */
+template <typename C>
+bool segmented_less (const C& x, const C& y) {
+    typedef std::pair<typename C::const_pointer, typename C::size_type> segment;
+    typename C::const_iterator b = x.begin();
+    typename C::const_iterator c = y.begin();
+    typename C::const_iterator e = x.end();
+    typename C::const_iterator f = y.end();
+    while ((b != e) && (c != f)) {
+        const segment                s = x.segment(b);
+        const segment                t = y.segment(c);
+        const typename C::size_type  k = std::min(s.second, t.second);
+        const std::pair<typename C::const_pointer, typename C::const_pointer> p =
+            std::mismatch(s.first, s.first + k, t.first);
+        if (p.first != s.first + k)
+            return *p.first < *p.second;
+        b += k;
+        c += k;}
+    return (b == e) && (c != f);}
+
+// --------------
+// segmented_copy
+// --------------
+
+/**
+ * std::copy(x.begin(), x.end(), out), a run at a time
+ */
+template <typename C, typename O>
+O segmented_copy (const C& x, O out) {
+    typename C::const_iterator b = x.begin();
+    typename C::const_iterator e = x.end();
+    while (b != e) {
+        const std::pair<typename C::const_pointer, typename C::size_type> s = x.segment(b);
+        out = std::copy(s.first, s.first + s.second, out);
+        b += s.second;}
+    return out;}
+
+// --------------
+// segmented_fill
+// --------------
+
+/**
+ * std::fill(x.begin(), x.end(), v), a run at a time
+ */
+template <typename C>
+void segmented_fill (C& x, const typename C::value_type& v) {
+    typename C::iterator b = x.begin();
+    typename C::iterator e = x.end();
+    while (b != e) {
+        const std::pair<typename C::pointer, typename C::size_type> s = x.segment(b);
+        std::fill(s.first, s.first + s.second, v);
+        b += s.second;}}
+
+#endif // Segments_h
@@ -0,0 +1,228 @@
+// ------------------------------
+// projects/deque/StealableDeque.h
+// Copyright (C) 2012
+// Glenn P. Downing
+// ------------------------------
+
+#ifndef StealableDeque_h
+#define StealableDeque_h
+
+/*
+StealableDeque<T> is a Chase-Lev work-stealing deque, in the C++11 form of
+Le, Pop, Cohen, and Zappa Nardelli, "Correct and Efficient Work-Stealing
+for Weak Memory Models" (PPoPP 2013). Needs C++11.
+
+One owner thread calls push_back and pop_back, and uses the back as a stack;
+any number of other threads call steal, which takes from the front.
+Only the last element is ever contended, and only then does the owner pay
+for a compare-and-swap.
+
+The elements sit in a circular block that doubles when it fills. A thief can
+still be reading an outgrown block, so those are kept until the deque is
+destroyed; that costs at most as much again as the largest block.
+T has to be trivially copyable (task pointers, indices), because a thief
+copies an element before it knows whether it won it.
+*/
+
+// --------
+// includes
+// --------
+
+#include <atomic>      // atomic, atomic_thread_fence, memory_order
+#include <cstddef>     // ptrdiff_t, size_t
+#include <type_traits> // is_trivially_copyable
+#include <vector>      // vector
+
+// --------------
+// StealableDeque
+// --------------
+
+template <typename T>
+class StealableDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "StealableDeque<T> needs a trivially copyable T");
+
+    public:
+        // --------
+        // typedefs
+        // --------
+
+        typedef T              value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::size_t    size_type;
+
+    private:
+        // -----
+        // Block
+        // -----
+
+        /**
+         * a circular array whose size is a power of two
+         */
+        class Block {
+            private:
+                const difference_type    _mask;
+                std::atomic<value_type>* _a;
+
+            public:
+                explicit Block (difference_type s) :
+                        _mask (s - 1),
+                        _a    (new std::atomic<value_type>[s])
+                    {}
+
+                Block             (const Block&) = delete;
+                Block& operator = (const Block&) = delete;
+
+                ~Block () {
+                    delete [] _a;}
+
+                difference_type size () const {
+                    return _mask + 1;}
+
+                value_type get (difference_type i) const {
+                    return _a[i & _mask].load(std::memory_order_relaxed);}
+
+                void put (difference_type i, const value_type& v) {
+                    _a[i & _mask].store(v, std::memory_order_relaxed);}
+
+                /**
+                 * a block twice the size holding [t, b)
+                 */
+                Block* grow (difference_type t, difference_type b) const {
+                    Block* const a = new Block(2 * size());
+                    for (difference_type i = t; i != b; ++i)
+                        a->put(i, get(i));
+                    return a;}};
+
+    private:
+        // ----
+        // data
+        // ----
+
+        // padded apart, so the owner and the thieves do not share cache lines
+        std::atomic<difference_type> _top;
+        char                         _pad0[64];
+        std::atomic<difference_type> _bottom;
+        std::atomic<Block*>          _block;
+        char                         _pad1[64];
+
+        // owner only
+        std::vector<Block*> _old;
+
+    public:
+        // ------------
+        // constructors
+        // ------------
+
+        /**
+         * s is rounded up to a power of two
+         */
+        explicit StealableDeque (size_type s = 64) :
+                _top    (0),
+                _bottom (0) {
+            difference_type n = 1;
+            while (n < static_cast<difference_type>(s))
+                n *= 2;
+            _block.store(new Block(n), std::memory_order_relaxed);}
+
+        StealableDeque             (const StealableDeque&) = delete;
+        StealableDeque& operator = (const StealableDeque&) = delete;
+
+        // ----------
+        // destructor
+        // ----------
+
+        ~StealableDeque () {
+            delete _block.load(std::memory_order_relaxed);
+            for (size_type i = 0; i != _old.size(); ++i)
+                delete _old[i];}
+
+        // ---------
+        // push_back
+        // ---------
+
+        /**
+         * owner only
+         */
+        void push_back (const value_type& v) {
+            const difference_type b = _bottom.load(std::memory_order_relaxed);
+            const difference_type t = _top.load(std::memory_order_acquire);
+            Block*                a = _block.load(std::memory_order_relaxed);
+            if (b - t > a->size() - 1) {
+                Block* const n = a->grow(t, b);
+                _old.push_back(a);
+                _block.store(n, std::memory_order_release);
+                a = n;}
+            a->put(b, v);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(b + 1, std::memory_order_relaxed);}
+
+        // --------
+        // pop_back
+        // --------
+
+        /**
+         * owner only: takes the most recently pushed element,
+         * or returns false, leaving v alone, if the deque is empty
+         */
+        bool pop_back (value_type& v) {
+            const difference_type b = _bottom.load(std::memory_order_relaxed) - 1;
+            Block* const          a = _block.load(std::memory_order_relaxed);
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            difference_type t = _top.load(std::memory_order_relaxed);
+            if (t > b) {
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return false;}
+            const value_type w = a->get(b);
+            if (t < b) {
+                v = w;
+                return true;}
+            // the last element: race the thieves for it
+            const bool r = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            if (r)
+                v = w;
+            return r;}
+
+        // -----
+        // steal
+        // -----
+
+        /**
+         * any thread: takes the least recently pushed element,
+         * or returns false, leaving v alone, if the deque is empty
+         * or another thread got there first
+         */
+        bool steal (value_type& v) {
+            difference_type t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const difference_type b = _bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return false;
+            const Block* const a = _block.load(std::memory_order_acquire);
+            const value_type   w = a->get(t);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return false;
+            v = w;
+            return true;}
+
+        // ----
+        // size
+        // ----
+
+        /**
+         * a snapshot, exact only when no other thread is using the deque
+         */
+        size_type size () const {
+            const difference_type b = _bottom.load(std::memory_order_relaxed);
+            const difference_type t = _top.load(std::memory_order_relaxed);
+            return (b > t) ? b - t : 0;}
+
+        // -----
+        // empty
+        // -----
+
+        bool empty () const {
+            return size() == 0;}};
+
+#endif // StealableDeque_h
@@ -0,0 +1,255 @@
+// --------------------------------------
+// projects/deque/TestConcurrentDeque.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// --------------------------------------
+
+/*
+To test the program:
+    % g++ -std=c++11 -pedantic -Wall -pthread TestConcurrentDeque.c++ -o TestConcurrentDeque.c++.app -lcppunit -ldl
+    % valgrind TestConcurrentDeque.c++.app >& TestConcurrentDeque.out
+
+To check it for data races:
+    % g++ -std=c++11 -g -O1 -fsanitize=thread -pthread TestConcurrentDeque.c++ -o TestConcurrentDeque.c++.tsan -lcppunit -ldl
+    % TestConcurrentDeque.c++.tsan
+*/
+
+// --------
+// includes
+// --------
+
+#include <memory>  // unique_ptr
+#include <string>  // string
+#include <thread>  // thread, yield
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "ConcurrentDeque.h"
+
+// -------
+// Tracked
+// -------
+
+/**
+ * counts the instances alive, to catch elements that are never destroyed
+ */
+struct Tracked {
+    static int alive;
+
+    int v;
+
+    Tracked (int i = 0) :
+            v (i) {
+        ++alive;}
+
+    Tracked (const Tracked& that) :
+            v (that.v) {
+        ++alive;}
+
+    Tracked& operator = (const Tracked&) = default;
+
+    ~Tracked () {
+        --alive;}};
+
+int Tracked::alive = 0;
+
+// -------------------
+// TestConcurrentDeque
+// -------------------
+
+template <typename C>
+struct TestConcurrentDeque : CppUnit::TestFixture {
+    // ----
+    // pump
+    // ----
+
+    /**
+     * one thread pushes 0, 1, ..., n - 1 while this one pops them;
+     * returns the number that came out in order
+     */
+    static int pump (C& x, int n) {
+        std::thread p(
+            [&x, n] () {
+                for (int i = 0; i != n; ++i)
+                    x.push_back(i);});
+        int i = 0;
+        int v;
+        while (i != n) {
+            if (!x.try_pop_front(v)) {
+                std::this_thread::yield();
+                continue;}
+            if (v != i)
+                break;
+            ++i;}
+        p.join();
+        return i;}
+
+    // -----
+    // empty
+    // -----
+
+    void test_empty_1 () {
+        C x;
+        int v = 7;
+        CPPUNIT_ASSERT(x.empty());
+        CPPUNIT_ASSERT(!x.try_pop_front(v));
+        CPPUNIT_ASSERT(v == 7);}
+
+    void test_empty_2 () {
+        C x;
+        int v;
+        x.push_back(2);
+        CPPUNIT_ASSERT(!x.empty());
+        CPPUNIT_ASSERT(x.try_pop_front(v));
+        CPPUNIT_ASSERT(v == 2);
+        CPPUNIT_ASSERT(x.empty());
+        CPPUNIT_ASSERT(!x.try_pop_front(v));}
+
+    // ---------
+    // push_back
+    // ---------
+
+    void test_push_back_1 () {
+        C x;
+        int v;
+        for (int i = 0; i != 10000; ++i)
+            x.push_back(i);
+        for (int i = 0; i != 10000; ++i) {
+            CPPUNIT_ASSERT(x.try_pop_front(v));
+            CPPUNIT_ASSERT(v == i);}
+        CPPUNIT_ASSERT(x.empty());}
+
+    void test_push_back_2 () {
+        C x;
+        int v;
+        for (int i = 0; i != 3000; ++i) {
+            x.push_back(2 * i);
+            x.emplace_back(2 * i + 1);
+            CPPUNIT_ASSERT(x.try_pop_front(v));
+            CPPUNIT_ASSERT(v == i);}
+        for (int i = 3000; i != 6000; ++i) {
+            CPPUNIT_ASSERT(x.try_pop_front(v));
+            CPPUNIT_ASSERT(v == i);}
+        CPPUNIT_ASSERT(x.empty());}
+
+    // -------
+    // threads
+    // -------
+
+    void test_threads_1 () {
+        C x;
+        CPPUNIT_ASSERT(pump(x, 1000) == 1000);
+        CPPUNIT_ASSERT(x.empty());}
+
+    void test_threads_2 () {
+        C x;
+        CPPUNIT_ASSERT(pump(x, 1000000) == 1000000);
+        CPPUNIT_ASSERT(x.empty());}
+
+    void test_threads_3 () {
+        C x;
+        for (int i = 0; i != 10; ++i)
+            CPPUNIT_ASSERT(pump(x, 10000) == 10000);
+        CPPUNIT_ASSERT(x.empty());}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestConcurrentDeque);
+    CPPUNIT_TEST(test_empty_1);
+    CPPUNIT_TEST(test_empty_2);
+    CPPUNIT_TEST(test_push_back_1);
+    CPPUNIT_TEST(test_push_back_2);
+    CPPUNIT_TEST(test_threads_1);
+    CPPUNIT_TEST(test_threads_2);
+    CPPUNIT_TEST(test_threads_3);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ------------------------
+// TestConcurrentDequeTypes
+// ------------------------
+
+struct TestConcurrentDequeTypes : CppUnit::TestFixture {
+    // ----------
+    // destructor
+    // ----------
+
+    void test_destructor_1 () {
+        {
+        ConcurrentMyDeque<Tracked, 4> x;
+        Tracked v;
+        for (int i = 0; i != 11; ++i)
+            x.emplace_back(i);
+        CPPUNIT_ASSERT(x.try_pop_front(v));
+        CPPUNIT_ASSERT(x.try_pop_front(v));
+        CPPUNIT_ASSERT(x.try_pop_front(v));
+        CPPUNIT_ASSERT(x.try_pop_front(v));
+        CPPUNIT_ASSERT(x.try_pop_front(v));
+        CPPUNIT_ASSERT(v.v == 4);
+        CPPUNIT_ASSERT(Tracked::alive == 7);
+        }
+        CPPUNIT_ASSERT(Tracked::alive == 0);}
+
+    // ---------
+    // move_only
+    // ---------
+
+    void test_move_only_1 () {
+        ConcurrentMyDeque<std::unique_ptr<int>, 4> x;
+        std::unique_ptr<int> v;
+        for (int i = 0; i != 10; ++i)
+            x.push_back(std::unique_ptr<int>(new int(i)));
+        for (int i = 0; i != 9; ++i) {
+            CPPUNIT_ASSERT(x.try_pop_front(v));
+            CPPUNIT_ASSERT(*v == i);}}
+
+    // ------
+    // string
+    // ------
+
+    void test_string_1 () {
+        ConcurrentMyDeque<std::string> x;
+        std::thread p(
+            [&x] () {
+                for (int i = 0; i != 100000; ++i)
+                    x.emplace_back(1 + i % 100, 'a' + i % 26);});
+        std::string v;
+        for (int i = 0; i != 100000; )
+            if (x.try_pop_front(v)) {
+                CPPUNIT_ASSERT(v == std::string(1 + i % 100, 'a' + i % 26));
+                ++i;}
+        p.join();
+        CPPUNIT_ASSERT(x.empty());}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestConcurrentDequeTypes);
+    CPPUNIT_TEST(test_destructor_1);
+    CPPUNIT_TEST(test_move_only_1);
+    CPPUNIT_TEST(test_string_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestConcurrentDeque.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestConcurrentDeque< ConcurrentMyDeque<int>    >::suite());
+    tr.addTest(TestConcurrentDeque< ConcurrentMyDeque<int, 1> >::suite());
+    tr.addTest(TestConcurrentDeque< ConcurrentMyDeque<int, 5> >::suite());
+    tr.addTest(TestConcurrentDequeTypes::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,295 @@
+// ------------------------------
+// projects/deque/TestDequeIO.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// ------------------------------
+
+/*
+To test the program:
+    % g++ -ansi -pedantic -Wall TestDequeIO.c++ -o TestDequeIO.c++.app -lcppunit -ldl
+    % valgrind TestDequeIO.c++.app >& TestDequeIO.out
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // equal
+#include <cstdlib>   // mkstemp
+#include <cstring>   // strcpy
+#include <deque>     // deque
+#include <memory>    // allocator
+#include <stdexcept> // invalid_argument, out_of_range, runtime_error
+
+#include <unistd.h> // close, ftruncate, lseek, pipe, unlink, write
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "BlockPolicy.h"
+#include "Deque.h"
+#include "DequeIO.h"
+
+// --------
+// TempFile
+// --------
+
+/**
+ * a scratch file that is gone when this is
+ */
+struct TempFile {
+    char name[32];
+    int  fd;
+
+    TempFile () {
+        std::strcpy(name, "/tmp/TestDequeIO.XXXXXX");
+        fd = mkstemp(name);
+        if (fd < 0)
+            throw std::runtime_error("TempFile: mkstemp");}
+
+    ~TempFile () {
+        ::close(fd);
+        ::unlink(name);}
+
+    void rewind () {
+        ::lseek(fd, 0, SEEK_SET);}};
+
+// -----------
+// TestDequeIO
+// -----------
+
+template <typename C>
+struct TestDequeIO : CppUnit::TestFixture {
+    typedef typename C::value_type T;
+
+    /**
+     * n elements, built from both ends
+     */
+    static C build (int n) {
+        C x;
+        for (int i = 0; i != n; ++i)
+            if (i % 2)
+                x.push_back(T(i));
+            else
+                x.push_front(T(i));
+        return x;}
+
+    /**
+     * y, after a round trip of x through a file
+     */
+    static void round_trip (const C& x, C& y) {
+        TempFile f;
+        save(f.fd, x);
+        f.rewind();
+        load(f.fd, y);}
+
+    // ------
+    // equals
+    // ------
+
+    void test_equals_1 () {
+        const C x;
+        C       y(3, T(2));
+        round_trip(x, y);
+        CPPUNIT_ASSERT(y.empty());
+        CPPUNIT_ASSERT(x == y);}
+
+    void test_equals_2 () {
+        const C x(3, T(11));
+        C       y;
+        round_trip(x, y);
+        CPPUNIT_ASSERT(y.size() == 3);
+        CPPUNIT_ASSERT(x == y);}
+
+    void test_equals_3 () {
+        const C x = build(100001);
+        C       y;
+        round_trip(x, y);
+        CPPUNIT_ASSERT(y.size() == 100001);
+        CPPUNIT_ASSERT(x == y);}
+
+    void test_equals_4 () {
+        const C x = build(600);
+        C       y = build(3000);
+        round_trip(x, y);
+        CPPUNIT_ASSERT(y.size() == 600);
+        CPPUNIT_ASSERT(x == y);}
+
+    void test_equals_5 () {
+        // checkpoints one after another in the same file
+        const C  x = build(600);
+        const C  y = build(7);
+        C        u;
+        C        v;
+        TempFile f;
+        save(f.fd, x);
+        save(f.fd, y);
+        f.rewind();
+        load(f.fd, u);
+        load(f.fd, v);
+        CPPUNIT_ASSERT(x == u);
+        CPPUNIT_ASSERT(y == v);}
+
+    // ------
+    // mapped
+    // ------
+
+    void test_mapped_1 () {
+        const C  x = build(100001);
+        TempFile f;
+        save(f.fd, x);
+        const MappedDeque<T> m(f.name);
+        CPPUNIT_ASSERT(m.size() == 100001);
+        CPPUNIT_ASSERT(std::equal(m.begin(), m.end(), x.begin()));
+        CPPUNIT_ASSERT(m.front()    == x.front());
+        CPPUNIT_ASSERT(m.back()     == x.back());
+        CPPUNIT_ASSERT(m[50000]     == x[50000]);
+        CPPUNIT_ASSERT(*(m.end() - 2) == x[99999]);}
+
+    void test_mapped_2 () {
+        const C  x;
+        TempFile f;
+        save(f.fd, x);
+        const MappedDeque<T> m(f.name);
+        CPPUNIT_ASSERT(m.empty());
+        CPPUNIT_ASSERT(m.begin() == m.end());}
+
+    void test_mapped_3 () {
+        const C  x(3, T(7));
+        TempFile f;
+        save(f.fd, x);
+        const MappedDeque<T> m(f.name);
+        CPPUNIT_ASSERT(m.at(2) == T(7));
+        try {
+            m.at(3);
+            CPPUNIT_ASSERT(false);}
+        catch (std::out_of_range&) {}}
+
+    // ---
+    // bad
+    // ---
+
+    void test_bad_1 () {
+        // the wrong element size
+        const C  x(3, T(7));
+        TempFile f;
+        save(f.fd, x);
+        f.rewind();
+        std::deque<char> y;
+        try {
+            load(f.fd, y);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}
+        try {
+            const MappedDeque<char> m(f.name);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}}
+
+    void test_bad_2 () {
+        // truncated
+        const C  x = build(600);
+        TempFile f;
+        save(f.fd, x);
+        CPPUNIT_ASSERT(::ftruncate(f.fd, sizeof(DequeHeader) + 100 * sizeof(T)) == 0);
+        f.rewind();
+        C y(3, T(2));
+        try {
+            load(f.fd, y);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}
+        CPPUNIT_ASSERT(y == C(3, T(2)));
+        try {
+            const MappedDeque<T> m(f.name);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}}
+
+    void test_bad_3 () {
+        // not a deque at all
+        TempFile f;
+        const char s[] = "this is not a deque, but it is long enough to look like one";
+        CPPUNIT_ASSERT(::write(f.fd, s, sizeof(s)) == static_cast<ssize_t>(sizeof(s)));
+        f.rewind();
+        C y;
+        try {
+            load(f.fd, y);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}
+        try {
+            const MappedDeque<T> m(f.name);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}}
+
+    void test_bad_4 () {
+        // a header that claims far more elements than the file holds
+        TempFile          f;
+        const DequeHeader h = DequeHeader::make(sizeof(T), 1UL << 62);
+        CPPUNIT_ASSERT(::write(f.fd, &h, sizeof(h)) == static_cast<ssize_t>(sizeof(h)));
+        f.rewind();
+        C y;
+        try {
+            load(f.fd, y);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}
+        try {
+            const MappedDeque<T> m(f.name);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}}
+
+    void test_bad_5 () {
+        // the same through a pipe, which cannot be checked until it runs dry
+        int p[2];
+        CPPUNIT_ASSERT(::pipe(p) == 0);
+        const DequeHeader h = DequeHeader::make(sizeof(T), 1UL << 62);
+        CPPUNIT_ASSERT(::write(p[1], &h, sizeof(h)) == static_cast<ssize_t>(sizeof(h)));
+        const T v[3] = {T(1), T(2), T(3)};
+        CPPUNIT_ASSERT(::write(p[1], v, sizeof(v)) == static_cast<ssize_t>(sizeof(v)));
+        ::close(p[1]);
+        C y;
+        try {
+            load(p[0], y);
+            CPPUNIT_ASSERT(false);}
+        catch (std::invalid_argument&) {}
+        ::close(p[0]);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeIO);
+    CPPUNIT_TEST(test_equals_1);
+    CPPUNIT_TEST(test_equals_2);
+    CPPUNIT_TEST(test_equals_3);
+    CPPUNIT_TEST(test_equals_4);
+    CPPUNIT_TEST(test_equals_5);
+    CPPUNIT_TEST(test_mapped_1);
+    CPPUNIT_TEST(test_mapped_2);
+    CPPUNIT_TEST(test_mapped_3);
+    CPPUNIT_TEST(test_bad_1);
+    CPPUNIT_TEST(test_bad_2);
+    CPPUNIT_TEST(test_bad_3);
+    CPPUNIT_TEST(test_bad_4);
+    CPPUNIT_TEST(test_bad_5);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestDequeIO.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestDequeIO< MyDeque<int>                                    >::suite());
+    tr.addTest(TestDequeIO<   deque<int>                                    >::suite());
+    tr.addTest(TestDequeIO< MyDeque<double>                                 >::suite());
+    tr.addTest(TestDequeIO<   deque<double>                                 >::suite());
+    tr.addTest(TestDequeIO< MyDeque<int, allocator<int>, FixedBlock<1> >     >::suite()); // gathered into the buffer
+    tr.addTest(TestDequeIO< MyDeque<int, allocator<int>, FixedBlock<32768> > >::suite()); // written a block at a time
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,485 @@
+// --------------------------------
+// projects/deque/TestDequeMove.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// --------------------------------
+
+/*
+To test the program:
+    % g++ -std=c++11 -pedantic -Wall TestDequeMove.c++ -o TestDequeMove.c++.app -lcppunit -ldl
+    % valgrind TestDequeMove.c++.app >& TestDequeMove.out
+
+MyDeque has to provide a move constructor, move assignment,
+push_back/push_front/insert of an rvalue, and emplace_back/emplace_front,
+and it has to move, never copy, elements when it shifts them.
+*/
+
+// --------
+// includes
+// --------
+
+#include <deque>   // deque
+#include <memory>  // unique_ptr
+#include <string>  // string
+#include <utility> // move
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "Deque.h"
+
+// -------
+// Counted
+// -------
+
+/**
+ * An int that counts how often it is copied and moved.
+ */
+struct Counted {
+    static int copies;
+    static int moves;
+
+    int v;
+
+    static void reset () {
+        copies = 0;
+        moves  = 0;}
+
+    Counted (int i = 0) :
+            v (i)
+        {}
+
+    Counted (const Counted& that) :
+            v (that.v) {
+        ++copies;}
+
+    Counted (Counted&& that) :
+            v (that.v) {
+        ++moves;}
+
+    Counted& operator = (const Counted& that) {
+        v = that.v;
+        ++copies;
+        return *this;}
+
+    Counted& operator = (Counted&& that) {
+        v = that.v;
+        ++moves;
+        return *this;}};
+
+int Counted::copies = 0;
+int Counted::moves  = 0;
+
+// -------------
+// TestDequeMove
+// -------------
+
+template <typename C>
+struct TestDequeMove : CppUnit::TestFixture {
+    // ----
+    // fill
+    // ----
+
+    static void fill (C& x, int n) {
+        for (int i = 0; i != n; ++i)
+            x.emplace_back(i);}
+
+    // -------------
+    // emplace_back
+    // -------------
+
+    void test_emplace_back_1 () {
+        C x;
+        Counted::reset();
+        x.emplace_back(3);
+        CPPUNIT_ASSERT(x.size()   == 1);
+        CPPUNIT_ASSERT(x.back().v == 3);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 0);}
+
+    void test_emplace_back_2 () {
+        C x;
+        Counted::reset();
+        fill(x, 1000);
+        CPPUNIT_ASSERT(x.size() == 1000);
+        for (int i = 0; i != 1000; ++i)
+            CPPUNIT_ASSERT(x[i].v == i);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 0);}
+
+    // -------------
+    // emplace_front
+    // -------------
+
+    void test_emplace_front_1 () {
+        C x;
+        Counted::reset();
+        x.emplace_front(3);
+        CPPUNIT_ASSERT(x.size()    == 1);
+        CPPUNIT_ASSERT(x.front().v == 3);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 0);}
+
+    void test_emplace_front_2 () {
+        C x;
+        Counted::reset();
+        for (int i = 0; i != 1000; ++i)
+            x.emplace_front(i);
+        CPPUNIT_ASSERT(x.size() == 1000);
+        for (int i = 0; i != 1000; ++i)
+            CPPUNIT_ASSERT(x[i].v == 999 - i);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 0);}
+
+    // ---------
+    // push_back
+    // ---------
+
+    void test_push_back_1 () {
+        C x;
+        Counted v(5);
+        Counted::reset();
+        x.push_back(std::move(v));
+        CPPUNIT_ASSERT(x.back().v == 5);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 1);}
+
+    void test_push_back_2 () {
+        C x;
+        fill(x, 300);
+        Counted::reset();
+        for (int i = 0; i != 300; ++i)
+            x.push_back(Counted(i));
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 300);}
+
+    // ----------
+    // push_front
+    // ----------
+
+    void test_push_front_1 () {
+        C x;
+        Counted v(5);
+        Counted::reset();
+        x.push_front(std::move(v));
+        CPPUNIT_ASSERT(x.front().v == 5);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 1);}
+
+    // ------
+    // insert
+    // ------
+
+    void test_insert_1 () {
+        C x;
+        fill(x, 600);
+        Counted::reset();
+        x.insert(x.begin() + 300, Counted(-1));
+        CPPUNIT_ASSERT(x.size()     == 601);
+        CPPUNIT_ASSERT(x[299].v     == 299);
+        CPPUNIT_ASSERT(x[300].v     == -1);
+        CPPUNIT_ASSERT(x[301].v     == 300);
+        CPPUNIT_ASSERT(Counted::copies == 0);}
+
+    // -----
+    // erase
+    // -----
+
+    void test_erase_1 () {
+        C x;
+        fill(x, 600);
+        Counted::reset();
+        x.erase(x.begin() + 300);
+        CPPUNIT_ASSERT(x.size()     == 599);
+        CPPUNIT_ASSERT(x[299].v     == 299);
+        CPPUNIT_ASSERT(x[300].v     == 301);
+        CPPUNIT_ASSERT(Counted::copies == 0);}
+
+    // ------
+    // resize
+    // ------
+
+    void test_resize_1 () {
+        C x;
+        fill(x, 10);
+        Counted::reset();
+        x.resize(3000);
+        CPPUNIT_ASSERT(x.size()   == 3000);
+        CPPUNIT_ASSERT(x[9].v     == 9);
+        CPPUNIT_ASSERT(x[2999].v  == 0);
+        CPPUNIT_ASSERT(Counted::copies == 0);}
+
+    // ----------------
+    // move_constructor
+    // ----------------
+
+    void test_move_constructor_1 () {
+        C x;
+        fill(x, 600);
+        Counted::reset();
+        C y(std::move(x));
+        CPPUNIT_ASSERT(y.size()   == 600);
+        CPPUNIT_ASSERT(y[599].v   == 599);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 0);}
+
+    void test_move_constructor_2 () {
+        C x;
+        fill(x, 600);
+        C y(std::move(x));
+        x.clear();
+        x.emplace_back(7);
+        CPPUNIT_ASSERT(x.size()    == 1);
+        CPPUNIT_ASSERT(x.front().v == 7);}
+
+    // ---------------
+    // move_assignment
+    // ---------------
+
+    void test_move_assignment_1 () {
+        C x;
+        C y;
+        fill(x, 600);
+        fill(y, 3);
+        Counted::reset();
+        y = std::move(x);
+        CPPUNIT_ASSERT(y.size()   == 600);
+        CPPUNIT_ASSERT(y[599].v   == 599);
+        CPPUNIT_ASSERT(Counted::copies == 0);
+        CPPUNIT_ASSERT(Counted::moves  == 0);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeMove);
+    CPPUNIT_TEST(test_emplace_back_1);
+    CPPUNIT_TEST(test_emplace_back_2);
+    CPPUNIT_TEST(test_emplace_front_1);
+    CPPUNIT_TEST(test_emplace_front_2);
+    CPPUNIT_TEST(test_push_back_1);
+    CPPUNIT_TEST(test_push_back_2);
+    CPPUNIT_TEST(test_push_front_1);
+    CPPUNIT_TEST(test_insert_1);
+    CPPUNIT_TEST(test_erase_1);
+    CPPUNIT_TEST(test_resize_1);
+    CPPUNIT_TEST(test_move_constructor_1);
+    CPPUNIT_TEST(test_move_constructor_2);
+    CPPUNIT_TEST(test_move_assignment_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ---------------
+// TestDequeString
+// ---------------
+
+template <typename C>
+struct TestDequeString : CppUnit::TestFixture {
+    // too long for the small-string buffer, so a copy has to allocate
+    static std::string s (int i) {
+        return std::string(64, 'a' + i % 26);}
+
+    // ---------
+    // push_back
+    // ---------
+
+    void test_push_back_1 () {
+        C x;
+        std::string v = s(0);
+        const char* const p = v.data();
+        x.push_back(std::move(v));
+        CPPUNIT_ASSERT(x.back()        == s(0));
+        CPPUNIT_ASSERT(x.back().data() == p);}
+
+    // ----------
+    // push_front
+    // ----------
+
+    void test_push_front_1 () {
+        C x;
+        std::string v = s(1);
+        const char* const p = v.data();
+        x.push_front(std::move(v));
+        CPPUNIT_ASSERT(x.front()        == s(1));
+        CPPUNIT_ASSERT(x.front().data() == p);}
+
+    // ------------
+    // emplace_back
+    // ------------
+
+    void test_emplace_back_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(64, 'a' + i % 26);
+        CPPUNIT_ASSERT(x.size() == 600);
+        for (int i = 0; i != 600; ++i)
+            CPPUNIT_ASSERT(x[i] == s(i));}
+
+    // ------
+    // insert
+    // ------
+
+    void test_insert_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(s(i));
+        const char* const p = x[300].data();
+        x.insert(x.begin() + 100, s(25));
+        CPPUNIT_ASSERT(x[100]        == s(25));
+        CPPUNIT_ASSERT(x[301]        == s(300));
+        CPPUNIT_ASSERT(x[301].data() == p);}
+
+    // ----------------
+    // move_constructor
+    // ----------------
+
+    void test_move_constructor_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(s(i));
+        const char* const p = x[599].data();
+        C y(std::move(x));
+        CPPUNIT_ASSERT(y.size()       == 600);
+        CPPUNIT_ASSERT(y[599].data()  == p);}
+
+    // ---------------
+    // move_assignment
+    // ---------------
+
+    void test_move_assignment_1 () {
+        C x;
+        C y(3, s(3));
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(s(i));
+        const char* const p = x[0].data();
+        y = std::move(x);
+        CPPUNIT_ASSERT(y.size()     == 600);
+        CPPUNIT_ASSERT(y[0].data()  == p);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeString);
+    CPPUNIT_TEST(test_push_back_1);
+    CPPUNIT_TEST(test_push_front_1);
+    CPPUNIT_TEST(test_emplace_back_1);
+    CPPUNIT_TEST(test_insert_1);
+    CPPUNIT_TEST(test_move_constructor_1);
+    CPPUNIT_TEST(test_move_assignment_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// -----------------
+// TestDequeMoveOnly
+// -----------------
+
+/**
+ * C holds std::unique_ptr<int>, so any copy of an element fails to compile.
+ */
+template <typename C>
+struct TestDequeMoveOnly : CppUnit::TestFixture {
+    typedef std::unique_ptr<int> pointer;
+
+    // ------------
+    // emplace_back
+    // ------------
+
+    void test_emplace_back_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(new int(i));
+        x.emplace_front(new int(-1));
+        CPPUNIT_ASSERT(x.size()     == 601);
+        CPPUNIT_ASSERT(*x.front()   == -1);
+        CPPUNIT_ASSERT(*x.back()    == 599);}
+
+    // ---------
+    // push_back
+    // ---------
+
+    void test_push_back_1 () {
+        C x;
+        pointer p(new int(2));
+        x.push_back(std::move(p));
+        x.push_front(pointer(new int(1)));
+        CPPUNIT_ASSERT(!p);
+        CPPUNIT_ASSERT(*x[0] == 1);
+        CPPUNIT_ASSERT(*x[1] == 2);}
+
+    // ---
+    // pop
+    // ---
+
+    void test_pop_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(new int(i));
+        x.pop_front();
+        x.pop_back();
+        CPPUNIT_ASSERT(x.size()     == 598);
+        CPPUNIT_ASSERT(*x.front()   == 1);
+        CPPUNIT_ASSERT(*x.back()    == 598);}
+
+    // --------------
+    // insert / erase
+    // --------------
+
+    void test_insert_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(new int(i));
+        x.insert(x.begin() + 300, pointer(new int(-1)));
+        CPPUNIT_ASSERT(*x[300] == -1);
+        x.erase(x.begin() + 300);
+        CPPUNIT_ASSERT(x.size() == 600);
+        for (int i = 0; i != 600; ++i)
+            CPPUNIT_ASSERT(*x[i] == i);}
+
+    // ----------------
+    // move_constructor
+    // ----------------
+
+    void test_move_constructor_1 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.emplace_back(new int(i));
+        C y(std::move(x));
+        C z;
+        z = std::move(y);
+        CPPUNIT_ASSERT(z.size()  == 600);
+        CPPUNIT_ASSERT(*z[599]   == 599);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeMoveOnly);
+    CPPUNIT_TEST(test_emplace_back_1);
+    CPPUNIT_TEST(test_push_back_1);
+    CPPUNIT_TEST(test_pop_1);
+    CPPUNIT_TEST(test_insert_1);
+    CPPUNIT_TEST(test_move_constructor_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestDequeMove.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestDequeMove    < MyDeque<Counted>              >::suite());
+    tr.addTest(TestDequeMove    <   deque<Counted>              >::suite());
+    tr.addTest(TestDequeString  < MyDeque<string>               >::suite());
+    tr.addTest(TestDequeString  <   deque<string>               >::suite());
+    tr.addTest(TestDequeMoveOnly< MyDeque< unique_ptr<int> >    >::suite());
+    tr.addTest(TestDequeMoveOnly<   deque< unique_ptr<int> >    >::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,231 @@
+// ----------------------------------
+// projects/deque/TestDequePolicy.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// ----------------------------------
+
+/*
+To test the program:
+    % g++ -ansi -pedantic -Wall TestDequePolicy.c++ -o TestDequePolicy.c++.app -lcppunit -ldl
+    % valgrind TestDequePolicy.c++.app >& TestDequePolicy.out
+
+MyDeque<T, A, P> has to take its block size from P::block_size<T>::value
+and keep up to P::inline_capacity elements without allocating;
+the TestDeque harnesses run the full suite over several policies.
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // equal
+#include <cstddef>   // size_t
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "BlockPolicy.h"
+#include "CountingAllocator.h"
+#include "Deque.h"
+
+// -----
+// Large
+// -----
+
+struct Large {
+    char a[1000];};
+
+// ---------------
+// TestBlockPolicy
+// ---------------
+
+struct TestBlockPolicy : CppUnit::TestFixture {
+    // ----------
+    // FixedBlock
+    // ----------
+
+    void test_fixed_1 () {
+        CPPUNIT_ASSERT(FixedBlock<8>::block_size<char>::value  == 8);
+        CPPUNIT_ASSERT(FixedBlock<8>::block_size<Large>::value == 8);
+        CPPUNIT_ASSERT(FixedBlock<8>::inline_capacity          == 0);}
+
+    void test_fixed_2 () {
+        CPPUNIT_ASSERT(FixedBlock<0>::block_size<int>::value == 1);}
+
+    // ----------
+    // BytesBlock
+    // ----------
+
+    void test_bytes_1 () {
+        CPPUNIT_ASSERT(BytesBlock<4096>::block_size<char>::value  == 4096);
+        CPPUNIT_ASSERT(BytesBlock<4096>::block_size<Large>::value == 4);
+        CPPUNIT_ASSERT(BytesBlock<100>::block_size<Large>::value  == 1);}
+
+    // --------------
+    // CacheLineBlock
+    // --------------
+
+    void test_cache_line_1 () {
+        CPPUNIT_ASSERT((CacheLineBlock<1, 64>::block_size<char>::value   == 64));
+        CPPUNIT_ASSERT((CacheLineBlock<16, 64>::block_size<double>::value == 128));
+        CPPUNIT_ASSERT((CacheLineBlock<1, 64>::block_size<Large>::value  == 1));}
+
+    // -----------
+    // InlineBlock
+    // -----------
+
+    void test_inline_1 () {
+        CPPUNIT_ASSERT(InlineBlock<16>::inline_capacity == 16);
+        CPPUNIT_ASSERT(InlineBlock<16>::block_size<int>::value == DefaultBlock::block_size<int>::value);
+        CPPUNIT_ASSERT((InlineBlock<3, FixedBlock<5> >::block_size<Large>::value == 5));}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestBlockPolicy);
+    CPPUNIT_TEST(test_fixed_1);
+    CPPUNIT_TEST(test_fixed_2);
+    CPPUNIT_TEST(test_bytes_1);
+    CPPUNIT_TEST(test_cache_line_1);
+    CPPUNIT_TEST(test_inline_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ---------------
+// TestDequeInline
+// ---------------
+
+/**
+ * C is a MyDeque<int, CountingAllocator<int>, P> with P::inline_capacity == 16
+ */
+template <typename C>
+struct TestDequeInline : CppUnit::TestFixture {
+    void setUp () {
+        reset_allocation_counts();}
+
+    static std::size_t allocations () {
+        return allocation_counts().allocations;}
+
+    // -----------
+    // constructor
+    // -----------
+
+    void test_constructor_1 () {
+        {
+        C x;
+        CPPUNIT_ASSERT(x.empty());
+        }
+        CPPUNIT_ASSERT(allocations() == 0);}
+
+    void test_constructor_2 () {
+        {
+        C x(3, 11);
+        CPPUNIT_ASSERT(x.size() == 3);
+        CPPUNIT_ASSERT(x[0] == 11);
+        CPPUNIT_ASSERT(x[2] == 11);
+        }
+        CPPUNIT_ASSERT(allocations() == 0);}
+
+    void test_constructor_3 () {
+        const C x(16, 2);
+        const C y(x);
+        C       z;
+        z = y;
+        CPPUNIT_ASSERT(z.size() == 16);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), z.begin()));
+        CPPUNIT_ASSERT(allocations() == 0);}
+
+    // ----
+    // push
+    // ----
+
+    void test_push_1 () {
+        C x;
+        for (int i = 0; i != 16; ++i)
+            x.push_back(i);
+        CPPUNIT_ASSERT(allocations() == 0);
+        x.push_back(16);
+        CPPUNIT_ASSERT(allocations() != 0);
+        CPPUNIT_ASSERT(x.size() == 17);
+        for (int i = 0; i != 17; ++i)
+            CPPUNIT_ASSERT(x[i] == i);}
+
+    void test_push_2 () {
+        C x;
+        for (int i = 0; i != 8; ++i) {
+            x.push_front(-i);
+            x.push_back(i);}
+        CPPUNIT_ASSERT(x.size()  == 16);
+        CPPUNIT_ASSERT(x.front() == -7);
+        CPPUNIT_ASSERT(x.back()  == 7);
+        CPPUNIT_ASSERT(allocations() == 0);}
+
+    void test_push_3 () {
+        // a work queue that never holds more than a few elements
+        C x;
+        for (int i = 0; i != 3000; ++i) {
+            x.push_back(i);
+            if (x.size() > 10)
+                x.pop_front();}
+        CPPUNIT_ASSERT(x.size()  == 10);
+        CPPUNIT_ASSERT(x.front() == 2990);
+        CPPUNIT_ASSERT(allocations() == 0);}
+
+    void test_push_4 () {
+        C x;
+        for (int i = 0; i != 600; ++i)
+            x.push_back(i);
+        while (x.size() != 5)
+            x.pop_back();
+        x.push_front(-1);
+        CPPUNIT_ASSERT(x.size() == 6);
+        CPPUNIT_ASSERT(x[0] == -1);
+        CPPUNIT_ASSERT(x[5] == 4);}
+
+    // ----
+    // swap
+    // ----
+
+    void test_swap_1 () {
+        C x(3, 1);
+        C y(600, 2);
+        x.swap(y);
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(y.size() == 3);
+        CPPUNIT_ASSERT(x[599] == 2);
+        CPPUNIT_ASSERT(y[2]   == 1);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeInline);
+    CPPUNIT_TEST(test_constructor_1);
+    CPPUNIT_TEST(test_constructor_2);
+    CPPUNIT_TEST(test_constructor_3);
+    CPPUNIT_TEST(test_push_1);
+    CPPUNIT_TEST(test_push_2);
+    CPPUNIT_TEST(test_push_3);
+    CPPUNIT_TEST(test_push_4);
+    CPPUNIT_TEST(test_swap_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestDequePolicy.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestBlockPolicy::suite());
+    tr.addTest(TestDequeInline< MyDeque<int, CountingAllocator<int>, InlineBlock<16>                > >::suite());
+    tr.addTest(TestDequeInline< MyDeque<int, CountingAllocator<int>, InlineBlock<16, FixedBlock<4> > > >::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,301 @@
+// ---------------------------------
+// projects/deque/TestDequeRange.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// ---------------------------------
+
+/*
+To test the program:
+    % g++ -ansi -pedantic -Wall TestDequeRange.c++ -o TestDequeRange.c++.app -lcppunit -ldl
+    % valgrind TestDequeRange.c++.app >& TestDequeRange.out
+
+MyDeque has to provide the range constructor and range insert of std::deque,
+plus append(first, last) and prepend(first, last), which add a whole range
+at the back or the front a block at a time. Everything runs over int, which
+takes the memcpy path, and over string, which has to take the element-wise one.
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // equal
+#include <deque>     // deque
+#include <list>      // list
+#include <sstream>   // ostringstream
+#include <string>    // string
+#include <vector>    // vector
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "Deque.h"
+
+// ----
+// make
+// ----
+
+inline int make (int i, const int*) {
+    return i;}
+
+inline std::string make (int i, const std::string*) {
+    std::ostringstream out;
+    out << i;
+    return out.str();}
+
+// --------------
+// TestDequeRange
+// --------------
+
+template <typename C>
+struct TestDequeRange : CppUnit::TestFixture {
+    typedef typename C::value_type T;
+
+    static T v (int i) {
+        return make(i, static_cast<const T*>(0));}
+
+    /**
+     * [b, e) as a vector of T
+     */
+    static std::vector<T> range (int b, int e) {
+        std::vector<T> x;
+        for (int i = b; i != e; ++i)
+            x.push_back(v(i));
+        return x;}
+
+    // -----------
+    // constructor
+    // -----------
+
+    void test_constructor_1 () {
+        const std::vector<T> a = range(0, 3000);
+        const C x(a.begin(), a.end());
+        CPPUNIT_ASSERT(x.size() == 3000);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    void test_constructor_2 () {
+        const std::vector<T> a;
+        const C x(a.begin(), a.end());
+        CPPUNIT_ASSERT(x.empty());}
+
+    void test_constructor_3 () {
+        const std::vector<T> a = range(0, 600);
+        const std::list<T>   b(a.begin(), a.end());
+        const C x(b.begin(), b.end());
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    // ----
+    // fill
+    // ----
+
+    void test_fill_1 () {
+        const C x(3000, v(7));
+        CPPUNIT_ASSERT(x.size() == 3000);
+        for (int i = 0; i != 3000; ++i)
+            CPPUNIT_ASSERT(x[i] == v(7));}
+
+    void test_fill_2 () {
+        C x(10, v(1));
+        x.resize(5000, v(9));
+        CPPUNIT_ASSERT(x.size() == 5000);
+        for (int i = 0; i != 10; ++i)
+            CPPUNIT_ASSERT(x[i] == v(1));
+        for (int i = 10; i != 5000; ++i)
+            CPPUNIT_ASSERT(x[i] == v(9));}
+
+    // ------
+    // insert
+    // ------
+
+    void test_insert_1 () {
+        const std::vector<T> a = range(0, 10);
+        const std::vector<T> b = range(10, 3010);
+        C x(a.begin(), a.end());
+        x.insert(x.begin() + 5, b.begin(), b.end());
+        CPPUNIT_ASSERT(x.size() == 3010);
+        CPPUNIT_ASSERT(std::equal(x.begin(),        x.begin() + 5,    a.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 5,    x.begin() + 3005, b.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 3005, x.end(),          a.begin() + 5));}
+
+    void test_insert_2 () {
+        const std::vector<T> a = range(0, 600);
+        const std::vector<T> b = range(600, 700);
+        C x(a.begin(), a.end());
+        x.insert(x.begin(), b.begin(), b.end());
+        CPPUNIT_ASSERT(x.size() == 700);
+        CPPUNIT_ASSERT(std::equal(x.begin(),       x.begin() + 100, b.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 100, x.end(),         a.begin()));}
+
+    void test_insert_3 () {
+        const std::vector<T> a = range(0, 600);
+        const std::vector<T> b = range(600, 700);
+        C x(a.begin(), a.end());
+        x.insert(x.end(), b.begin(), b.end());
+        CPPUNIT_ASSERT(x.size() == 700);
+        CPPUNIT_ASSERT(std::equal(x.begin(),       x.begin() + 600, a.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 600, x.end(),         b.begin()));}
+
+    void test_insert_4 () {
+        const std::vector<T> a = range(0, 600);
+        C x(a.begin(), a.end());
+        x.insert(x.begin() + 300, a.begin(), a.begin());
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeRange);
+    CPPUNIT_TEST(test_constructor_1);
+    CPPUNIT_TEST(test_constructor_2);
+    CPPUNIT_TEST(test_constructor_3);
+    CPPUNIT_TEST(test_fill_1);
+    CPPUNIT_TEST(test_fill_2);
+    CPPUNIT_TEST(test_insert_1);
+    CPPUNIT_TEST(test_insert_2);
+    CPPUNIT_TEST(test_insert_3);
+    CPPUNIT_TEST(test_insert_4);
+    CPPUNIT_TEST_SUITE_END();};
+
+// -------------
+// TestDequeBulk
+// -------------
+
+/**
+ * append and prepend are MyDeque only.
+ */
+template <typename C>
+struct TestDequeBulk : CppUnit::TestFixture {
+    typedef typename C::value_type T;
+
+    static std::vector<T> range (int b, int e) {
+        return TestDequeRange<C>::range(b, e);}
+
+    // ------
+    // append
+    // ------
+
+    void test_append_1 () {
+        const std::vector<T> a = range(0, 10);
+        C x;
+        x.append(a.begin(), a.end());
+        CPPUNIT_ASSERT(x.size() == 10);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    void test_append_2 () {
+        const std::vector<T> a = range(0, 5);
+        const std::vector<T> b = range(5, 3005);
+        C x(a.begin(), a.end());
+        x.append(b.begin(), b.end());
+        CPPUNIT_ASSERT(x.size() == 3005);
+        CPPUNIT_ASSERT(std::equal(x.begin(),     x.begin() + 5, a.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 5, x.end(),       b.begin()));}
+
+    void test_append_3 () {
+        const std::vector<T> a = range(0, 600);
+        C x(a.begin(), a.end());
+        x.append(a.end(), a.end());
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    void test_append_4 () {
+        const std::vector<T> a = range(0, 600);
+        const std::list<T>   b(a.begin(), a.end());
+        C x;
+        x.append(b.begin(), b.end());
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    void test_append_5 () {
+        const std::vector<T> a = range(0, 3000);
+        const C y(a.begin(), a.end());
+        C x;
+        x.push_front(a[0]);
+        x.pop_front();
+        x.append(y.begin(), y.end());
+        x.append(y.begin(), y.end());
+        CPPUNIT_ASSERT(x.size() == 6000);
+        CPPUNIT_ASSERT(std::equal(x.begin(),        x.begin() + 3000, a.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 3000, x.end(),          a.begin()));}
+
+    // -------
+    // prepend
+    // -------
+
+    void test_prepend_1 () {
+        const std::vector<T> a = range(0, 3);
+        const std::vector<T> b = range(3, 5);
+        C x(b.begin(), b.end());
+        x.prepend(a.begin(), a.end());
+        CPPUNIT_ASSERT(x.size() == 5);
+        CPPUNIT_ASSERT(std::equal(x.begin(),     x.begin() + 3, a.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 3, x.end(),       b.begin()));}
+
+    void test_prepend_2 () {
+        const std::vector<T> a = range(0, 3000);
+        const std::vector<T> b = range(3000, 3005);
+        C x(b.begin(), b.end());
+        x.prepend(a.begin(), a.end());
+        CPPUNIT_ASSERT(x.size() == 3005);
+        CPPUNIT_ASSERT(std::equal(x.begin(),        x.begin() + 3000, a.begin()));
+        CPPUNIT_ASSERT(std::equal(x.begin() + 3000, x.end(),          b.begin()));}
+
+    void test_prepend_3 () {
+        const std::vector<T> a = range(0, 600);
+        const std::list<T>   b(a.begin(), a.end());
+        C x;
+        x.prepend(b.begin(), b.end());
+        x.prepend(b.end(), b.end());
+        CPPUNIT_ASSERT(x.size() == 600);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), a.begin()));}
+
+    void test_prepend_4 () {
+        const std::vector<T> a = range(0, 600);
+        C x;
+        for (int i = 0; i != 10; ++i) {
+            x.append(a.begin(), a.end());
+            x.prepend(a.begin(), a.end());}
+        CPPUNIT_ASSERT(x.size() == 12000);
+        for (int i = 0; i != 20; ++i)
+            CPPUNIT_ASSERT(std::equal(x.begin() + 600 * i, x.begin() + 600 * (i + 1), a.begin()));}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeBulk);
+    CPPUNIT_TEST(test_append_1);
+    CPPUNIT_TEST(test_append_2);
+    CPPUNIT_TEST(test_append_3);
+    CPPUNIT_TEST(test_append_4);
+    CPPUNIT_TEST(test_append_5);
+    CPPUNIT_TEST(test_prepend_1);
+    CPPUNIT_TEST(test_prepend_2);
+    CPPUNIT_TEST(test_prepend_3);
+    CPPUNIT_TEST(test_prepend_4);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestDequeRange.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestDequeRange< MyDeque<int>    >::suite());
+    tr.addTest(TestDequeRange<   deque<int>    >::suite());
+    tr.addTest(TestDequeRange< MyDeque<string> >::suite());
+    tr.addTest(TestDequeRange<   deque<string> >::suite());
+    tr.addTest(TestDequeBulk < MyDeque<int>    >::suite());
+    tr.addTest(TestDequeBulk < MyDeque<string> >::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,254 @@
+// -----------------------------------
+// projects/deque/TestDequeSegment.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// -----------------------------------
+
+/*
+To test the program:
+    % g++ -ansi -pedantic -Wall TestDequeSegment.c++ -o TestDequeSegment.c++.app -lcppunit -ldl
+    % valgrind TestDequeSegment.c++.app >& TestDequeSegment.out
+
+MyDeque has to provide segment(iterator) and segment(const_iterator) const
+(see Segments.h), and its ==, <, and friends should agree with the
+segmented algorithms however the blocks of the two sides line up.
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // count, equal, find
+#include <cstddef>   // size_t
+#include <vector>    // vector
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "Deque.h"
+#include "PoolAllocator.h"
+#include "Segments.h"
+
+// -------
+// Collect
+// -------
+
+/**
+ * appends each run it is handed to a vector, and remembers the run sizes
+ */
+struct Collect {
+    std::vector<int>*         values;
+    std::vector<std::size_t>* sizes;
+
+    Collect (std::vector<int>& v, std::vector<std::size_t>& s) :
+            values (&v),
+            sizes  (&s)
+        {}
+
+    void operator () (const int* p, std::size_t k) {
+        values->insert(values->end(), p, p + k);
+        sizes->push_back(k);}};
+
+// ----------------
+// TestDequeSegment
+// ----------------
+
+template <typename C>
+struct TestDequeSegment : CppUnit::TestFixture {
+    // -----
+    // build
+    // -----
+
+    /**
+     * 0, 1, ..., n - 1, built from the back
+     */
+    static C back (int n) {
+        C x;
+        for (int i = 0; i != n; ++i)
+            x.push_back(i);
+        return x;}
+
+    /**
+     * 0, 1, ..., n - 1, built from the front, so the blocks sit differently
+     */
+    static C front (int n) {
+        C x;
+        for (int i = n - 1; i >= 0; --i)
+            x.push_front(i);
+        return x;}
+
+    // -------
+    // segment
+    // -------
+
+    void test_segment_1 () {
+        const C x = back(3000);
+        typename C::const_iterator b = x.begin() + 1234;
+        const std::pair<typename C::const_pointer, typename C::size_type> s = x.segment(b);
+        CPPUNIT_ASSERT(s.first  == &*b);
+        CPPUNIT_ASSERT(s.second >= 1);
+        CPPUNIT_ASSERT(s.second <= static_cast<typename C::size_type>(x.end() - b));
+        CPPUNIT_ASSERT(std::equal(s.first, s.first + s.second, b));}
+
+    void test_segment_2 () {
+        C x = front(600);
+        typename C::iterator b = x.end() - 1;
+        const std::pair<typename C::pointer, typename C::size_type> s = x.segment(b);
+        CPPUNIT_ASSERT(s.first  == &*b);
+        CPPUNIT_ASSERT(s.second == 1);
+        *s.first = -1;
+        CPPUNIT_ASSERT(x.back() == -1);}
+
+    // ----------------
+    // for_each_segment
+    // ----------------
+
+    void test_for_each_segment_1 () {
+        const C x;
+        std::vector<int>         v;
+        std::vector<std::size_t> s;
+        for_each_segment(x, Collect(v, s));
+        CPPUNIT_ASSERT(v.empty());
+        CPPUNIT_ASSERT(s.empty());}
+
+    void test_for_each_segment_2 () {
+        const C x = back(3000);
+        std::vector<int>         v;
+        std::vector<std::size_t> s;
+        for_each_segment(x, Collect(v, s));
+        CPPUNIT_ASSERT(v.size() == 3000);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), v.begin()));
+        CPPUNIT_ASSERT(std::find(s.begin(), s.end(), 0U) == s.end());}
+
+    void test_for_each_segment_3 () {
+        C x = front(3000);
+        x.pop_front();
+        x.pop_back();
+        std::vector<int>         v;
+        std::vector<std::size_t> s;
+        for_each_segment(x, Collect(v, s));
+        CPPUNIT_ASSERT(v.size() == 2998);
+        CPPUNIT_ASSERT(v.front() == 1);
+        CPPUNIT_ASSERT(v.back()  == 2998);
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), v.begin()));}
+
+    // -----
+    // equal
+    // -----
+
+    void test_equal_1 () {
+        const C x = back(3000);
+        const C y = front(3000);
+        CPPUNIT_ASSERT(segmented_equal(x, y));
+        CPPUNIT_ASSERT(x == y);}
+
+    void test_equal_2 () {
+        const C x = back(3000);
+        for (int i = 0; i < 3000; i += 7) {
+            C y = front(3000);
+            y[i] = -1;
+            CPPUNIT_ASSERT(!segmented_equal(x, y));
+            CPPUNIT_ASSERT(x != y);}}
+
+    void test_equal_3 () {
+        const C x = back(600);
+        const C y = back(601);
+        CPPUNIT_ASSERT(!segmented_equal(x, y));
+        CPPUNIT_ASSERT(x != y);}
+
+    // ----
+    // less
+    // ----
+
+    void test_less_1 () {
+        const C x = back(3000);
+        const C y = front(3000);
+        CPPUNIT_ASSERT(!segmented_less(x, y));
+        CPPUNIT_ASSERT(!segmented_less(y, x));
+        CPPUNIT_ASSERT(!(x < y));
+        CPPUNIT_ASSERT(x <= y);}
+
+    void test_less_2 () {
+        const C x = back(3000);
+        for (int i = 0; i < 3000; i += 7) {
+            C y = front(3000);
+            y[i] = 5000;
+            CPPUNIT_ASSERT( segmented_less(x, y));
+            CPPUNIT_ASSERT(!segmented_less(y, x));
+            CPPUNIT_ASSERT(x < y);
+            CPPUNIT_ASSERT(y > x);}}
+
+    void test_less_3 () {
+        const C x = back(600);
+        const C y = front(601);
+        CPPUNIT_ASSERT( segmented_less(x, y));
+        CPPUNIT_ASSERT(!segmented_less(y, x));
+        CPPUNIT_ASSERT(x < y);}
+
+    void test_less_4 () {
+        const C x;
+        const C y = back(1);
+        CPPUNIT_ASSERT( segmented_less(x, y));
+        CPPUNIT_ASSERT(!segmented_less(x, x));}
+
+    // ----
+    // copy
+    // ----
+
+    void test_copy_1 () {
+        C x = front(3000);
+        x.pop_front();
+        std::vector<int> v(x.size());
+        CPPUNIT_ASSERT(segmented_copy(x, v.begin()) == v.end());
+        CPPUNIT_ASSERT(std::equal(x.begin(), x.end(), v.begin()));}
+
+    // ----
+    // fill
+    // ----
+
+    void test_fill_1 () {
+        C x = front(3000);
+        x.pop_front();
+        segmented_fill(x, 7);
+        CPPUNIT_ASSERT(x.size() == 2999);
+        CPPUNIT_ASSERT(std::count(x.begin(), x.end(), 7) == 2999);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestDequeSegment);
+    CPPUNIT_TEST(test_segment_1);
+    CPPUNIT_TEST(test_segment_2);
+    CPPUNIT_TEST(test_for_each_segment_1);
+    CPPUNIT_TEST(test_for_each_segment_2);
+    CPPUNIT_TEST(test_for_each_segment_3);
+    CPPUNIT_TEST(test_equal_1);
+    CPPUNIT_TEST(test_equal_2);
+    CPPUNIT_TEST(test_equal_3);
+    CPPUNIT_TEST(test_less_1);
+    CPPUNIT_TEST(test_less_2);
+    CPPUNIT_TEST(test_less_3);
+    CPPUNIT_TEST(test_less_4);
+    CPPUNIT_TEST(test_copy_1);
+    CPPUNIT_TEST(test_fill_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestDequeSegment.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestDequeSegment< MyDeque<int>                     >::suite());
+    tr.addTest(TestDequeSegment< MyDeque<int, PoolAllocator<int> > >::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,213 @@
+// ------------------------------------
+// projects/deque/TestPoolAllocator.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// ------------------------------------
+
+/*
+To test the program:
+    % g++ -ansi -pedantic -Wall TestPoolAllocator.c++ -o TestPoolAllocator.c++.app -lcppunit -ldl
+    % valgrind TestPoolAllocator.c++.app >& TestPoolAllocator.out
+
+The TestDeque harnesses show that a MyDeque over PoolAllocator is correct;
+these show that it stops going back to the heap.
+*/
+
+// --------
+// includes
+// --------
+
+#include <cstddef> // size_t
+#include <cstdlib> // free, malloc
+#include <deque>   // deque
+#include <new>     // bad_alloc
+#include <vector>  // vector
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "Deque.h"
+#include "PoolAllocator.h"
+
+// ----------------
+// heap_allocations
+// ----------------
+
+std::size_t heap_allocations = 0;
+
+void* operator new (std::size_t s) throw (std::bad_alloc) {
+    ++heap_allocations;
+    if (void* const p = std::malloc(s ? s : 1))
+        return p;
+    throw std::bad_alloc();}
+
+void operator delete (void* p) throw () {
+    std::free(p);}
+
+void* operator new[] (std::size_t s) throw (std::bad_alloc) {
+    return operator new(s);}
+
+void operator delete[] (void* p) throw () {
+    operator delete(p);}
+
+// -------------
+// TestChunkPool
+// -------------
+
+struct TestChunkPool : CppUnit::TestFixture {
+    // -----
+    // reuse
+    // -----
+
+    void test_reuse_1 () {
+        ChunkPool   p;
+        void* const a = p.allocate(4096);
+        p.deallocate(a, 4096);
+        CPPUNIT_ASSERT(p.cached() == 4096);
+        const std::size_t n = heap_allocations;
+        CPPUNIT_ASSERT(p.allocate(4096) == a);
+        CPPUNIT_ASSERT(heap_allocations == n);
+        CPPUNIT_ASSERT(p.cached() == 0);
+        p.deallocate(a, 4096);}
+
+    void test_reuse_2 () {
+        // chunks only come back at their own size
+        ChunkPool   p;
+        void* const a = p.allocate(4096);
+        void* const b = p.allocate(512);
+        p.deallocate(a, 4096);
+        void* const c = p.allocate(512);
+        CPPUNIT_ASSERT(c != a);
+        p.deallocate(c, 512);
+        p.deallocate(b, 512);
+        CPPUNIT_ASSERT(p.allocate(512)  == b);
+        CPPUNIT_ASSERT(p.allocate(4096) == a);
+        p.deallocate(a, 4096);
+        p.deallocate(b, 512);}
+
+    // ----------
+    // max_pooled
+    // ----------
+
+    void test_max_pooled_1 () {
+        ChunkPool p;
+        p.deallocate(p.allocate(ChunkPool::max_pooled), ChunkPool::max_pooled);
+        CPPUNIT_ASSERT(p.cached() == ChunkPool::max_pooled);
+        p.release();
+        p.deallocate(p.allocate(ChunkPool::max_pooled + 1), ChunkPool::max_pooled + 1);
+        CPPUNIT_ASSERT(p.cached() == 0);}
+
+    // ----------
+    // max_cached
+    // ----------
+
+    void test_max_cached_1 () {
+        ChunkPool          p;
+        const std::size_t  k = 2 * ChunkPool::max_cached / 4096;
+        std::vector<void*> a(k);
+        for (std::size_t i = 0; i != k; ++i)
+            a[i] = p.allocate(4096);
+        for (std::size_t i = 0; i != k; ++i) {
+            p.deallocate(a[i], 4096);
+            CPPUNIT_ASSERT(p.cached() <= ChunkPool::max_cached);}
+        CPPUNIT_ASSERT(p.cached() == ChunkPool::max_cached);}
+
+    // -------
+    // release
+    // -------
+
+    void test_release_1 () {
+        ChunkPool   p;
+        void* const a = p.allocate(4096);
+        void* const b = p.allocate(4096);
+        p.deallocate(a, 4096);
+        p.deallocate(b, 4096);
+        CPPUNIT_ASSERT(p.cached() == 8192);
+        p.release();
+        CPPUNIT_ASSERT(p.cached() == 0);
+        const std::size_t n = heap_allocations;
+        p.deallocate(p.allocate(4096), 4096);
+        CPPUNIT_ASSERT(heap_allocations == n + 1);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestChunkPool);
+    CPPUNIT_TEST(test_reuse_1);
+    CPPUNIT_TEST(test_reuse_2);
+    CPPUNIT_TEST(test_max_pooled_1);
+    CPPUNIT_TEST(test_max_cached_1);
+    CPPUNIT_TEST(test_release_1);
+    CPPUNIT_TEST_SUITE_END();};
+
+// -----------------
+// TestPoolAllocator
+// -----------------
+
+/**
+ * C is a deque of int over PoolAllocator<int>
+ */
+template <typename C>
+struct TestPoolAllocator : CppUnit::TestFixture {
+    void setUp () {
+        chunk_pool().release();}
+
+    // -----
+    // cycle
+    // -----
+
+    void test_cycle_1 () {
+        // a sliding window: blocks freed at the back come back at the front
+        C x;
+        for (int i = 0; i != 1000; ++i)
+            x.push_front(i);
+        for (int i = 0; i != 10000; ++i) {
+            x.push_front(i);
+            x.pop_back();}
+        const std::size_t n = heap_allocations;
+        for (int i = 0; i != 100000; ++i) {
+            x.push_front(i);
+            x.pop_back();}
+        CPPUNIT_ASSERT(heap_allocations == n);
+        CPPUNIT_ASSERT(x.size()  == 1000);
+        CPPUNIT_ASSERT(x.front() == 99999);}
+
+    void test_cycle_2 () {
+        // a deque that is built up and torn down again
+        for (int i = 0; i != 3; ++i) {
+            C x(3000, 2);}
+        const std::size_t n = heap_allocations;
+        for (int i = 0; i != 10; ++i) {
+            C x(3000, 2);
+            CPPUNIT_ASSERT(x.size() == 3000);}
+        CPPUNIT_ASSERT(heap_allocations == n);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestPoolAllocator);
+    CPPUNIT_TEST(test_cycle_1);
+    CPPUNIT_TEST(test_cycle_2);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestPoolAllocator.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestChunkPool::suite());
+    tr.addTest(TestPoolAllocator< MyDeque<int, PoolAllocator<int> > >::suite());
+    tr.addTest(TestPoolAllocator<   deque<int, PoolAllocator<int> > >::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
@@ -0,0 +1,221 @@
+// -------------------------------------
+// projects/deque/TestStealableDeque.c++
+// Copyright (C) 2012
+// Glenn P. Downing
+// -------------------------------------
+
+/*
+To test the program:
+    % g++ -std=c++11 -pedantic -Wall -pthread TestStealableDeque.c++ -o TestStealableDeque.c++.app -lcppunit -ldl
+    % valgrind TestStealableDeque.c++.app >& TestStealableDeque.out
+
+To check it for data races:
+    % g++ -std=c++11 -g -O1 -fsanitize=thread -pthread TestStealableDeque.c++ -o TestStealableDeque.c++.tsan -lcppunit -ldl
+    % TestStealableDeque.c++.tsan
+ThreadSanitizer does not model the fences in StealableDeque (g++ warns with -Wtsan),
+so a clean run there is necessary but not sufficient.
+*/
+
+// --------
+// includes
+// --------
+
+#include <atomic>  // atomic
+#include <cstddef> // size_t
+#include <thread>  // thread, yield
+#include <vector>  // vector
+
+#include "cppunit/extensions/HelperMacros.h" // CPPUNIT_TEST, CPPUNIT_TEST_SUITE, CPPUNIT_TEST_SUITE_END
+#include "cppunit/TestFixture.h"             // TestFixture
+#include "cppunit/TestSuite.h"               // TestSuite
+#include "cppunit/TextTestRunner.h"          // TestRunner
+
+#include "StealableDeque.h"
+
+// ------------------
+// TestStealableDeque
+// ------------------
+
+struct TestStealableDeque : CppUnit::TestFixture {
+    typedef StealableDeque<int> C;
+
+    // ----
+    // race
+    // ----
+
+    /**
+     * the owner pushes 0, 1, ..., n - 1, popping one after every k pushes
+     * and draining at the end, while m thieves steal;
+     * returns how many times each value was taken, and counts in clobbered
+     * the failed pop_back and steal calls that wrote to their argument anyway
+     */
+    static std::vector<int> race (int n, int k, int m, int& clobbered) {
+        C                        x(2);
+        std::vector<int>         taken(n, 0);
+        std::atomic<bool>        done(false);
+        std::atomic<int>         lost(0);
+        std::vector<std::thread> thieves;
+        std::vector< std::vector<int> > stolen(m);
+        for (int j = 0; j != m; ++j)
+            thieves.push_back(std::thread(
+                [&x, &done, &stolen, &lost, j] () {
+                    int v = -1;
+                    while (!done.load()) {
+                        if (x.steal(v))
+                            stolen[j].push_back(v);
+                        else if (v != -1)
+                            ++lost;
+                        else
+                            std::this_thread::yield();
+                        v = -1;}
+                    while (x.steal(v)) {
+                        stolen[j].push_back(v);
+                        v = -1;}
+                    if (v != -1)
+                        ++lost;}));
+        int v = -1;
+        for (int i = 0; i != n; ++i) {
+            x.push_back(i);
+            if (i % k == 0) {
+                if (x.pop_back(v))
+                    ++taken[v];
+                else if (v != -1)
+                    ++lost;
+                v = -1;}}
+        while (!x.empty()) {
+            if (x.pop_back(v))
+                ++taken[v];
+            else if (v != -1)
+                ++lost;
+            v = -1;}
+        done.store(true);
+        for (int j = 0; j != m; ++j) {
+            thieves[j].join();
+            for (std::size_t i = 0; i != stolen[j].size(); ++i)
+                ++taken[stolen[j][i]];}
+        clobbered = lost.load();
+        return taken;}
+
+    // -----
+    // empty
+    // -----
+
+    void test_empty_1 () {
+        C x;
+        int v = 7;
+        CPPUNIT_ASSERT(x.empty());
+        CPPUNIT_ASSERT(!x.pop_back(v));
+        CPPUNIT_ASSERT(!x.steal(v));
+        CPPUNIT_ASSERT(v == 7);
+        CPPUNIT_ASSERT(x.empty());}
+
+    // --------
+    // pop_back
+    // --------
+
+    void test_pop_back_1 () {
+        C x;
+        int v;
+        x.push_back(1);
+        x.push_back(2);
+        x.push_back(3);
+        CPPUNIT_ASSERT(x.size() == 3);
+        CPPUNIT_ASSERT(x.pop_back(v) && (v == 3));
+        CPPUNIT_ASSERT(x.pop_back(v) && (v == 2));
+        CPPUNIT_ASSERT(x.pop_back(v) && (v == 1));
+        CPPUNIT_ASSERT(!x.pop_back(v));}
+
+    void test_pop_back_2 () {
+        C x(1);
+        int v;
+        for (int i = 0; i != 3000; ++i)
+            x.push_back(i);
+        CPPUNIT_ASSERT(x.size() == 3000);
+        for (int i = 2999; i >= 0; --i)
+            CPPUNIT_ASSERT(x.pop_back(v) && (v == i));
+        CPPUNIT_ASSERT(x.empty());}
+
+    // -----
+    // steal
+    // -----
+
+    void test_steal_1 () {
+        C x;
+        int v;
+        x.push_back(1);
+        x.push_back(2);
+        x.push_back(3);
+        CPPUNIT_ASSERT(x.steal(v) && (v == 1));
+        CPPUNIT_ASSERT(x.pop_back(v) && (v == 3));
+        CPPUNIT_ASSERT(x.steal(v) && (v == 2));
+        CPPUNIT_ASSERT(!x.steal(v));
+        CPPUNIT_ASSERT(!x.pop_back(v));}
+
+    void test_steal_2 () {
+        C x(4);
+        int v;
+        for (int i = 0; i != 600; ++i) {
+            x.push_back(2 * i);
+            x.push_back(2 * i + 1);
+            CPPUNIT_ASSERT(x.steal(v) && (v == i));}
+        CPPUNIT_ASSERT(x.size() == 600);
+        for (int i = 600; i != 1200; ++i)
+            CPPUNIT_ASSERT(x.steal(v) && (v == i));
+        CPPUNIT_ASSERT(x.empty());}
+
+    // -------
+    // threads
+    // -------
+
+    void test_threads_1 () {
+        int                    clobbered;
+        const std::vector<int> taken = race(100000, 1000000, 1, clobbered);
+        for (std::size_t i = 0; i != taken.size(); ++i)
+            CPPUNIT_ASSERT(taken[i] == 1);
+        CPPUNIT_ASSERT(clobbered == 0);}
+
+    void test_threads_2 () {
+        int                    clobbered;
+        const std::vector<int> taken = race(100000, 2, 3, clobbered);
+        for (std::size_t i = 0; i != taken.size(); ++i)
+            CPPUNIT_ASSERT(taken[i] == 1);
+        CPPUNIT_ASSERT(clobbered == 0);}
+
+    void test_threads_3 () {
+        // the owner keeps popping, so the last element is contended all the time
+        int                    clobbered;
+        const std::vector<int> taken = race(100000, 1, 4, clobbered);
+        for (std::size_t i = 0; i != taken.size(); ++i)
+            CPPUNIT_ASSERT(taken[i] == 1);
+        CPPUNIT_ASSERT(clobbered == 0);}
+
+    // -----
+    // suite
+    // -----
+
+    CPPUNIT_TEST_SUITE(TestStealableDeque);
+    CPPUNIT_TEST(test_empty_1);
+    CPPUNIT_TEST(test_pop_back_1);
+    CPPUNIT_TEST(test_pop_back_2);
+    CPPUNIT_TEST(test_steal_1);
+    CPPUNIT_TEST(test_steal_2);
+    CPPUNIT_TEST(test_threads_1);
+    CPPUNIT_TEST(test_threads_2);
+    CPPUNIT_TEST(test_threads_3);
+    CPPUNIT_TEST_SUITE_END();};
+
+// ----
+// main
+// ----
+
+int main () {
+    using namespace std;
+    ios_base::sync_with_stdio(false); // turn off synchronization with C I/O
+    cout << "TestStealableDeque.c++" << endl << endl;
+
+    CppUnit::TextTestRunner tr;
+    tr.addTest(TestStealableDeque::suite());
+    tr.run();
+
+    cout << "Done." << endl;
+    return 0;}
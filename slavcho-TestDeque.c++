@@ -23,6 +23,8 @@ To test the program:
 #include <algorithm> // equal
 #include <cstring>   // strcmp
 #include <deque>	 // deque
+#include <fstream>   // ofstream
+#include <memory>    // allocator
 #include <sstream>   // ostringstream
 #include <stdexcept> // invalid_argument
 #include <string>	// ==
@@ -32,7 +34,11 @@ To test the program:
 #include "cppunit/TestSuite.h"			   // TestSuite
 #include "cppunit/TextTestRunner.h"		  // TestRunner
 
+#include "AllocationListener.h"
+#include "BlockPolicy.h"
+#include "CountingAllocator.h"
 #include "Deque.h"
+#include "PoolAllocator.h"
 
 // ---------
 // TestDeque
@@ -2010,7 +2016,15 @@ int main () {
 	cout << "TestDeque.c++" << endl << endl;
 
 	CppUnit::TextTestRunner tr;
+	ofstream           allocs("TestDeque.allocs");
+	AllocationListener al(tr.eventManager(), allocs, "TestDeque.budget");
+	tr.eventManager().addListener(&al);
 	tr.addTest(TestDeque< MyDeque<int> >::suite());
+	tr.addTest(TestDeque< MyDeque<int, CountingAllocator<int> > >::suite());
+	tr.addTest(TestDeque< MyDeque<int, PoolAllocator<int> > >::suite());
+	tr.addTest(TestDeque< MyDeque<int, allocator<int>, FixedBlock<1> > >::suite());
+	tr.addTest(TestDeque< MyDeque<int, allocator<int>, CacheLineBlock<> > >::suite());
+	tr.addTest(TestDeque< MyDeque<int, allocator<int>, InlineBlock<16> > >::suite());
 	tr.addTest(TestDeque<   deque<int> >::suite());
 	tr.run();
 